@@ -7,10 +7,18 @@ int main(int argc, char **argv)
 
     // COMPILE WITH RAYLIB
     Nob_Cmd cmd = {0};          // SRC FILE
+
+    // Batch-Abfrage des Feldes für externe Werkzeuge, siehe src/Feldabfrage.h
+    nob_cmd_append(&cmd, "gcc", "-c", "src/Feldabfrage.c", "-O3", "-fno-math-errno", "-o", "./Feldabfrage.o");
+    if (!nob_cmd_run_sync(cmd)) return -1;
+    cmd.count = 0;
+    nob_cmd_append(&cmd, "ar", "rcs", "./libfeldabfrage.a", "./Feldabfrage.o");
+    if (!nob_cmd_run_sync(cmd)) return -1;
+    cmd.count = 0;
     
-    nob_cmd_append(&cmd, "gcc", "src/main.c", "src/Items.c", "-ggdb");
+    nob_cmd_append(&cmd, "gcc", "src/main.c", "src/Items.c", "-ggdb", "-O3", "-fno-math-errno");
     nob_cmd_append(&cmd, "-I", "./raylib-src/raylib-5.0_linux_amd64/include/");
-    nob_cmd_append(&cmd, "-L", "./raylib-src/raylib-5.0_linux_amd64/lib/", "-L", "./raylib-src/old-raygui-src/", "-l:libraylib.a", "-l:raygui.so", "-lm");
+    nob_cmd_append(&cmd, "-L", "./raylib-src/raylib-5.0_linux_amd64/lib/", "-L", "./raylib-src/old-raygui-src/", "-l:libraylib.a", "-l:raygui.so", "-lm", "-lpthread");
 
     // Main Exec File
     nob_cmd_append(&cmd, "-o", "./main");
@@ -0,0 +1,486 @@
+// Atlas.c
+// Vorberechneter Atlas der Interferenzpunkte: für jeden ganzzahligen Zustand
+// (lambda 10..85, gitterD 0..150, winkel 0..180, gut zwei Millionen) die
+// Punkte aus DrawInterferencePoints bei einer Referenzauflösung. Erzeugt wird
+// er offline mit "./main --atlas [datei]" über alle Kerne. Die App bildet die
+// Datei beim Start mit mmap ab, der Simulationsthread liest die Punkte dann
+// nur noch aus dem Seitencache, statt sie zu rechnen.
+//
+// Aufbau: Kopf, Index mit anzahl + 1 Offsets (uint64) und die Punktsätze.
+// Ein Punktsatz ist in Varints kodiert: Punktzahl, erste Zeile i1 und
+// Zeilenzahl, dann je Zeile die Punktzahl, das erste i2 als Differenz zur
+// Vorzeile und die Punkte. i2 ist innerhalb einer Zeile lückenlos (r2 wächst
+// mit i2, die Dreiecksungleichung schneidet ein Intervall heraus). Punkte
+// gleicher Differenz i2 - i1 liegen auf einer Hyperbel in etwa lambda
+// Abstand, jeder Punkt wird daher aus den zwei vorigen seiner Diagonale
+// linear vorhergesagt. Die Abweichung passt fast immer in ein Byte.
+//
+// Geschrieben wird in datei.tmp, umbenannt erst nach vollständigem Schreiben
+// und fsync; ein abgebrochener Lauf hinterlässt so keinen scheinbar gültigen
+// Atlas. Beim Öffnen müssen Kopf und Index zur Dateigröße passen, und jeder
+// Punktsatz wird nur innerhalb seiner Grenzen gelesen.
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ATLAS_DATEI "interferenz.atlas"
+#define ATLAS_MAGIC "DSATLAS1"
+#define ATLAS_STAPEL 8192           // Zustände je Schreibdurchgang
+#define ATLAS_KLEIN 7               // Abweichungen in [-7, 7] in einem Byte
+#define ATLAS_ESCAPE 255
+#define ATLAS_MAX_BEREICH 4096      // Obergrenze für lambda, gitterD und winkel im Kopf
+
+typedef struct {
+    char magic[8];
+    int32_t width, height;
+    int32_t lambdaMin, lambdaMax;
+    int32_t gitterDMin, gitterDMax;
+    int32_t winkelMin, winkelMax;
+    uint64_t anzahl;                // Zustände
+    uint64_t punkte;                // Punkte insgesamt, für den Bericht
+} AtlasKopf;
+
+typedef struct {
+    const AtlasKopf* kopf;
+    const uint64_t* index;          // anzahl + 1 Offsets ab Dateianfang
+    const unsigned char* daten;     // ganze Datei
+    size_t groesse;
+    atomic_long gelesen;
+} Atlas;
+
+static Atlas atlas = {0};
+
+typedef struct {
+    unsigned char* daten;
+    size_t laenge, kapazitaet;
+} AtlasPuffer;
+
+static void AtlasByte(AtlasPuffer* p, unsigned char b) {
+    if (p->laenge == p->kapazitaet) {
+        p->kapazitaet = p->kapazitaet ? 2 * p->kapazitaet : 256;
+        p->daten = realloc(p->daten, p->kapazitaet);
+    }
+    p->daten[p->laenge++] = b;
+}
+
+static void AtlasVarint(AtlasPuffer* p, uint32_t v) {
+    while (v >= 0x80) {
+        AtlasByte(p, (unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    AtlasByte(p, (unsigned char)v);
+}
+
+static uint32_t AtlasZickzack(int v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+// Lesezeiger in einem Punktsatz; wer über ende hinaus lesen will, setzt
+// fehler und bekommt 0.
+typedef struct {
+    const unsigned char* q;
+    const unsigned char* ende;
+    bool fehler;
+} AtlasLeser;
+
+static unsigned char AtlasByteLesen(AtlasLeser* l) {
+    if (l->q >= l->ende) {
+        l->fehler = true;
+        return 0;
+    }
+    return *l->q++;
+}
+
+static uint32_t AtlasVarintLesen(AtlasLeser* l) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        unsigned char b = AtlasByteLesen(l);
+        v |= (uint32_t)(b & 0x7f) << shift;
+        if (b < 0x80) return v;
+    }
+    l->fehler = true;
+    return 0;
+}
+
+static int AtlasZickzackLesen(AtlasLeser* l) {
+    uint32_t v = AtlasVarintLesen(l);
+    return (int)(v >> 1) ^ -(int)(v & 1);
+}
+
+static bool AtlasKlein(int v) {
+    return v >= -ATLAS_KLEIN && v <= ATLAS_KLEIN;
+}
+
+// Punkt (i1, i2) unter den schon bekannten Zeilen ab erste oder NULL.
+static const InterferenzPunkt* AtlasNachbar(const Interferenzpunkte* ip, int erste, int i1, int i2) {
+    if (i1 < erste) return NULL;
+    int begin = ip->zeilenStart[i1], end = ip->zeilenStart[i1 + 1];
+    if (begin == end) return NULL;
+    int i2Erster = ip->punkte[begin].i2;
+    if (i2 < i2Erster || i2 >= i2Erster + end - begin) return NULL;
+    return &ip->punkte[begin + i2 - i2Erster];
+}
+
+// Vorhersage für (i1, i2) aus der Diagonale (i1 - 1, i2 - 1), (i1 - 2, i2 - 2),
+// sonst aus dem linken Nachbarn der Zeile (links) oder der Vorzeile.
+static void AtlasVorhersage(const Interferenzpunkte* ip, int erste, int i1, int i2, const InterferenzPunkt* links,
+                            int* px, int* py) {
+    const InterferenzPunkt* d1 = AtlasNachbar(ip, erste, i1 - 1, i2 - 1);
+    const InterferenzPunkt* d2 = d1 ? AtlasNachbar(ip, erste, i1 - 2, i2 - 2) : NULL;
+    const InterferenzPunkt* oben = AtlasNachbar(ip, erste, i1 - 1, i2);
+    if (d2) {
+        *px = (int)(2u * (uint32_t)(int)d1->p.x - (uint32_t)(int)d2->p.x);
+        *py = (int)(2u * (uint32_t)(int)d1->p.y - (uint32_t)(int)d2->p.y);
+    } else {
+        const InterferenzPunkt* q = d1 ? d1 : links ? links : oben;
+        *px = q ? (int)q->p.x : 0;
+        *py = q ? (int)q->p.y : 0;
+    }
+}
+
+static void AtlasRestSchreiben(AtlasPuffer* p, int rx, int ry) {
+    if (AtlasKlein(rx) && AtlasKlein(ry)) {
+        AtlasByte(p, (unsigned char)((rx + ATLAS_KLEIN) * (2 * ATLAS_KLEIN + 1) + ry + ATLAS_KLEIN));
+    } else {
+        AtlasByte(p, ATLAS_ESCAPE);
+        AtlasVarint(p, AtlasZickzack(rx));
+        AtlasVarint(p, AtlasZickzack(ry));
+    }
+}
+
+static void AtlasRestLesen(AtlasLeser* l, int* rx, int* ry) {
+    unsigned char b = AtlasByteLesen(l);
+    if (b == ATLAS_ESCAPE) {
+        *rx = AtlasZickzackLesen(l);
+        *ry = AtlasZickzackLesen(l);
+    } else {
+        *rx = b / (2 * ATLAS_KLEIN + 1) - ATLAS_KLEIN;
+        *ry = b % (2 * ATLAS_KLEIN + 1) - ATLAS_KLEIN;
+    }
+}
+
+// Punkte eines Zustands, so wie PunkteRechnen sie ablegt (zeilenweise nach
+// i1, darin aufsteigend nach i2).
+static void AtlasKodieren(const Interferenzpunkte* ip, AtlasPuffer* p) {
+    p->laenge = 0;
+    AtlasVarint(p, ip->anzahl);
+    if (ip->anzahl == 0) return;
+
+    int erste = ip->punkte[0].i1;
+    int letzte = ip->punkte[ip->anzahl - 1].i1;
+    AtlasVarint(p, erste);
+    AtlasVarint(p, letzte - erste + 1);
+
+    int i2Vorher = 0;
+    for (int i1 = erste; i1 <= letzte; i1++) {
+        int begin = ip->zeilenStart[i1], end = ip->zeilenStart[i1 + 1];
+        AtlasVarint(p, end - begin);
+        if (end == begin) continue;
+        AtlasVarint(p, AtlasZickzack(ip->punkte[begin].i2 - i2Vorher));
+        i2Vorher = ip->punkte[begin].i2;
+
+        for (int k = begin; k < end; k++) {
+            const InterferenzPunkt* q = &ip->punkte[k];
+            int px, py;
+            AtlasVorhersage(ip, erste, i1, q->i2, k > begin ? q - 1 : NULL, &px, &py);
+            // Modulo 2^32: Punkte weit außerhalb liegen bei etwa +-2^31.
+            int rx = (int)((uint32_t)(int)q->p.x - (uint32_t)px), ry = (int)((uint32_t)(int)q->p.y - (uint32_t)py);
+            AtlasRestSchreiben(p, rx, ry);
+        }
+    }
+}
+
+// Gegenstück zu AtlasKodieren, füllt punkte und zeilenStart wie PunkteRechnen.
+// Die Vorhersage greift nur auf schon gelesene Zeilen und Punkte zurück.
+// false, wenn der Punktsatz [q, ende) nicht genau aufgeht oder Zeilen und
+// Punktzahlen nicht zu nWellen und der gelesenen Punktzahl passen.
+static bool AtlasDekodieren(const unsigned char* q, const unsigned char* ende, Interferenzpunkte* ip, int nWellen) {
+    AtlasLeser l = {q, ende, false};
+    uint32_t anzahl = AtlasVarintLesen(&l);
+    ip->anzahl = 0;
+    if (nWellen + 1 > ip->zeilenKapazitaet) {
+        ip->zeilenKapazitaet = nWellen + 1;
+        ip->zeilenStart = realloc(ip->zeilenStart, ip->zeilenKapazitaet * sizeof(int));
+    }
+    memset(ip->zeilenStart, 0, (nWellen + 1) * sizeof(int));
+    // Jeder Punkt braucht mindestens ein Byte.
+    if (l.fehler || anzahl > (uint32_t)(ende - l.q)) return false;
+    if (anzahl == 0) return l.q == ende;
+    if ((int)anzahl > ip->kapazitaet) {
+        ip->kapazitaet = (int)anzahl;
+        ip->punkte = realloc(ip->punkte, ip->kapazitaet * sizeof(InterferenzPunkt));
+    }
+
+    uint32_t erste = AtlasVarintLesen(&l);
+    uint32_t zeilen = AtlasVarintLesen(&l);
+    if (l.fehler || erste > (uint32_t)nWellen || zeilen > (uint32_t)nWellen - erste) return false;
+
+    int n = 0, i2Vorher = 0;
+    for (int i1 = (int)erste; i1 < (int)(erste + zeilen); i1++) {
+        uint32_t m = AtlasVarintLesen(&l);
+        if (l.fehler || m > anzahl - (uint32_t)n) return false;
+        if (m > 0) {
+            int i2 = i2Vorher + AtlasZickzackLesen(&l);
+            i2Vorher = i2;
+            for (int k = 0; k < (int)m; k++) {
+                int px, py, rx, ry;
+                AtlasVorhersage(ip, erste, i1, i2 + k, k > 0 ? &ip->punkte[n - 1] : NULL, &px, &py);
+                AtlasRestLesen(&l, &rx, &ry);
+                if (l.fehler) return false;
+                // Modulo 2^32 wie beim Kodieren.
+                int x = (int)((uint32_t)px + (uint32_t)rx), y = (int)((uint32_t)py + (uint32_t)ry);
+                ip->punkte[n++] = (InterferenzPunkt){{(float)x, (float)y}, i1, i2 + k};
+            }
+        }
+        ip->zeilenStart[i1 + 1] = n;
+    }
+    for (int i1 = (int)(erste + zeilen); i1 < nWellen; i1++) ip->zeilenStart[i1 + 1] = n;
+    if (n != (int)anzahl || l.q != ende) return false;
+    ip->anzahl = n;
+    return true;
+}
+
+static int64_t AtlasPlatz(const AtlasKopf* k, AppState* state) {
+    if (state->lambda < k->lambdaMin || state->lambda > k->lambdaMax || state->gitterD < k->gitterDMin ||
+        state->gitterD > k->gitterDMax || state->winkel < k->winkelMin || state->winkel > k->winkelMax) {
+        return -1;
+    }
+    int nD = k->gitterDMax - k->gitterDMin + 1, nW = k->winkelMax - k->winkelMin + 1;
+    return ((int64_t)(state->lambda - k->lambdaMin) * nD + (state->gitterD - k->gitterDMin)) * nW +
+           (state->winkel - k->winkelMin);
+}
+
+static void AtlasZustand(const AtlasKopf* k, int64_t platz, AppState* state) {
+    int nD = k->gitterDMax - k->gitterDMin + 1, nW = k->winkelMax - k->winkelMin + 1;
+    state->winkel = k->winkelMin + (int)(platz % nW);
+    state->gitterD = k->gitterDMin + (int)(platz / nW % nD);
+    state->lambda = k->lambdaMin + (int)(platz / nW / nD);
+}
+
+// Punkte aus dem Atlas statt aus PunkteRechnen, danach das Gitter der Sonde
+// wie sonst auch. false, wenn der Atlas Auflösung oder Zustand nicht kennt.
+static bool InterferenzpunkteAusAtlas(Atlas* a, Interferenzpunkte* ip, int breite, int hoehe, AppState* state) {
+    if (a->kopf == NULL || a->kopf->width != breite || a->kopf->height != hoehe) return false;
+    if (ip->width == breite && ip->height == hoehe && ip->gebaut.lambda == state->lambda &&
+        ip->gebaut.gitterD == state->gitterD && ip->gebaut.winkel == state->winkel) {
+        return true;
+    }
+    int64_t platz = AtlasPlatz(a->kopf, state);
+    if (platz < 0) return false;
+
+    double start = NowSeconds();
+    ip->radius = PunkteRadius(state->lambda);
+    if (!AtlasDekodieren(a->daten + a->index[platz], a->daten + a->index[platz + 1], ip, breite / state->lambda)) {
+        TraceLog(LOG_WARNING, "ATLAS: Punktsatz für lambda %d, gitterD %d, winkel %d ist kaputt", state->lambda,
+                 state->gitterD, state->winkel);
+        ip->width = 0;
+        return false;
+    }
+    GitterBauen(ip, breite, hoehe, state->lambda);
+    ip->rechenzeit = NowSeconds() - start;
+    ip->width = breite;
+    ip->height = hoehe;
+    ip->gebaut = *state;
+    atomic_fetch_add(&a->gelesen, 1);
+    return true;
+}
+
+// Kopf und Index gegen die Dateigröße: Bereiche und Zustandszahl stimmen
+// überein, die Offsets steigen ab dem Indexende und enden genau am Dateiende.
+static bool AtlasGueltig(const AtlasKopf* kopf, size_t groesse) {
+    if (memcmp(kopf->magic, ATLAS_MAGIC, 8) != 0 || kopf->width <= 0 || kopf->height <= 0) return false;
+    if (kopf->lambdaMin < 1 || kopf->gitterDMin < 0 || kopf->winkelMin < 0 || kopf->lambdaMax < kopf->lambdaMin ||
+        kopf->gitterDMax < kopf->gitterDMin || kopf->winkelMax < kopf->winkelMin ||
+        kopf->lambdaMax > ATLAS_MAX_BEREICH || kopf->gitterDMax > ATLAS_MAX_BEREICH ||
+        kopf->winkelMax > ATLAS_MAX_BEREICH) {
+        return false;
+    }
+    uint64_t anzahl = (uint64_t)(kopf->lambdaMax - kopf->lambdaMin + 1) * (kopf->gitterDMax - kopf->gitterDMin + 1) *
+                      (kopf->winkelMax - kopf->winkelMin + 1);
+    if (kopf->anzahl != anzahl || anzahl >= (groesse - sizeof(AtlasKopf)) / sizeof(uint64_t)) return false;
+
+    const uint64_t* index = (const uint64_t*)(kopf + 1);
+    uint64_t indexEnde = sizeof(AtlasKopf) + (anzahl + 1) * sizeof(uint64_t);
+    if (index[0] < indexEnde || index[anzahl] != groesse) return false;
+    for (uint64_t i = 0; i < anzahl; i++) {
+        if (index[i + 1] < index[i]) return false;
+    }
+    return true;
+}
+
+static bool AtlasOeffnen(Atlas* a, const char* datei) {
+    int fd = open(datei, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(AtlasKopf)) {
+        close(fd);
+        return false;
+    }
+    void* karte = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (karte == MAP_FAILED) return false;
+
+    const AtlasKopf* kopf = (const AtlasKopf*)karte;
+    if (!AtlasGueltig(kopf, st.st_size)) {
+        TraceLog(LOG_WARNING, "ATLAS: %s ist kein gültiger Atlas", datei);
+        munmap(karte, st.st_size);
+        return false;
+    }
+    madvise(karte, st.st_size, MADV_RANDOM);
+    a->kopf = kopf;
+    a->index = (const uint64_t*)(kopf + 1);
+    a->daten = (const unsigned char*)karte;
+    a->groesse = st.st_size;
+    TraceLog(LOG_INFO, "ATLAS: %s, %dx%d, %llu Zustände, %.1f MB", datei, kopf->width, kopf->height,
+             (unsigned long long)kopf->anzahl, a->groesse / 1048576.0);
+    return true;
+}
+
+static void AtlasSchliessen(Atlas* a) {
+    if (a->daten) munmap((void*)a->daten, a->groesse);
+    memset(a, 0, sizeof(*a));
+}
+
+typedef struct {
+    const AtlasKopf* kopf;
+    int64_t erster;
+    AtlasPuffer* puffer;
+    atomic_llong punkte;
+} AtlasAuftrag;
+
+static void AtlasStapel(void* ctx, int begin, int end) {
+    AtlasAuftrag* a = (AtlasAuftrag*)ctx;
+    Interferenzpunkte ip = {0};
+    long long punkte = 0;
+    for (int i = begin; i < end; i++) {
+        AppState state = {0};
+        AtlasZustand(a->kopf, a->erster + i, &state);
+        PunkteRechnen(&ip, a->kopf->width, a->kopf->height, &state);
+        AtlasKodieren(&ip, &a->puffer[i]);
+        punkte += ip.anzahl;
+    }
+    atomic_fetch_add(&a->punkte, punkte);
+    FreeInterferenzpunkte(&ip);
+}
+
+static bool AtlasSchreiben(FILE* f, const void* daten, size_t groesse, size_t anzahl) {
+    return anzahl == 0 || fwrite(daten, groesse, anzahl, f) == anzahl;
+}
+
+// Rechnet alle Zustände des Kopfs stapelweise im Thread-Pool und schreibt sie
+// der Reihe nach in datei.tmp. Der Index wird am Ende über den Platzhalter
+// geschrieben, erst danach wird die Datei umbenannt.
+static bool AtlasErzeugen(const char* datei, AtlasKopf kopf) {
+    memcpy(kopf.magic, ATLAS_MAGIC, 8);
+    kopf.anzahl = (uint64_t)(kopf.lambdaMax - kopf.lambdaMin + 1) * (kopf.gitterDMax - kopf.gitterDMin + 1) *
+                  (kopf.winkelMax - kopf.winkelMin + 1);
+    char tmp[4096];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", datei);
+    FILE* f = fopen(tmp, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Atlas: kann %s nicht schreiben\n", tmp);
+        return false;
+    }
+
+    uint64_t* index = calloc(kopf.anzahl + 1, sizeof(uint64_t));
+    AtlasPuffer* puffer = calloc(ATLAS_STAPEL, sizeof(AtlasPuffer));
+    bool ok = AtlasSchreiben(f, &kopf, sizeof(kopf), 1) && AtlasSchreiben(f, index, sizeof(uint64_t), kopf.anzahl + 1);
+    uint64_t offset = sizeof(kopf) + (kopf.anzahl + 1) * sizeof(uint64_t);
+
+    double start = NowSeconds();
+    AtlasAuftrag a = {&kopf, 0, puffer, 0};
+    int prozent = -1;
+    for (int64_t erster = 0; ok && erster < (int64_t)kopf.anzahl; erster += ATLAS_STAPEL) {
+        int n = kopf.anzahl - erster < ATLAS_STAPEL ? (int)(kopf.anzahl - erster) : ATLAS_STAPEL;
+        a.erster = erster;
+        ParallelFor(n, 64, AtlasStapel, &a);
+        for (int i = 0; ok && i < n; i++) {
+            index[erster + i] = offset;
+            ok = AtlasSchreiben(f, puffer[i].daten, 1, puffer[i].laenge);
+            offset += puffer[i].laenge;
+        }
+        if ((int)(100 * (erster + n) / kopf.anzahl) / 10 != prozent) {
+            prozent = (int)(100 * (erster + n) / kopf.anzahl) / 10;
+            fprintf(stderr, "Atlas: %d%%\n", prozent * 10);
+        }
+    }
+    index[kopf.anzahl] = offset;
+    kopf.punkte = atomic_load(&a.punkte);
+
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && AtlasSchreiben(f, &kopf, sizeof(kopf), 1) &&
+         AtlasSchreiben(f, index, sizeof(uint64_t), kopf.anzahl + 1) && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = fclose(f) == 0 && ok;
+    ok = ok && rename(tmp, datei) == 0;
+    if (!ok) {
+        fprintf(stderr, "Atlas: Schreiben von %s fehlgeschlagen\n", datei);
+        unlink(tmp);
+    }
+    double dauer = NowSeconds() - start;
+
+    if (ok) {
+        printf("Atlas %s: %dx%d, %llu Zustände, %llu Punkte\n", datei, kopf.width, kopf.height,
+               (unsigned long long)kopf.anzahl, (unsigned long long)kopf.punkte);
+        printf("  %.1f MB (Index %.1f MB), %.2f Byte je Punkt, %.1f s mit %d Threads\n", offset / 1048576.0,
+               (kopf.anzahl + 1) * sizeof(uint64_t) / 1048576.0,
+               kopf.punkte ? (double)(offset - sizeof(kopf) - (kopf.anzahl + 1) * sizeof(uint64_t)) / kopf.punkte
+                           : 0.0,
+               dauer, ThreadCount());
+    }
+
+    for (int i = 0; i < ATLAS_STAPEL; i++) free(puffer[i].daten);
+    free(puffer);
+    free(index);
+    return ok;
+}
+
+// Vergleicht jeden schritt-ten Zustand des abgebildeten Atlas mit der
+// laufenden Rechnung. Gibt die Zahl der Abweichungen zurück.
+static long AtlasPruefen(const Atlas* a, int64_t schritt) {
+    Interferenzpunkte live = {0}, gelesen = {0};
+    long fehler = 0, geprueft = 0;
+    double start = NowSeconds();
+    for (int64_t platz = 0; platz < (int64_t)a->kopf->anzahl; platz += schritt) {
+        AppState state = {0};
+        AtlasZustand(a->kopf, platz, &state);
+        PunkteRechnen(&live, a->kopf->width, a->kopf->height, &state);
+        bool gleich = AtlasDekodieren(a->daten + a->index[platz], a->daten + a->index[platz + 1], &gelesen,
+                                      a->kopf->width / state.lambda) &&
+                      live.anzahl == gelesen.anzahl;
+        for (int i = 0; gleich && i < live.anzahl; i++) {
+            gleich = live.punkte[i].p.x == gelesen.punkte[i].p.x && live.punkte[i].p.y == gelesen.punkte[i].p.y &&
+                     live.punkte[i].i1 == gelesen.punkte[i].i1 && live.punkte[i].i2 == gelesen.punkte[i].i2;
+        }
+        if (!gleich) {
+            if (fehler < 10) {
+                fprintf(stderr, "Atlas: Abweichung bei lambda %d, gitterD %d, winkel %d\n", state.lambda,
+                        state.gitterD, state.winkel);
+            }
+            fehler++;
+        }
+        geprueft++;
+    }
+    printf("Prüfung: %ld Zustände gegen die Rechnung, %ld Abweichungen, %.1f s\n", geprueft, fehler,
+           NowSeconds() - start);
+    FreeInterferenzpunkte(&live);
+    FreeInterferenzpunkte(&gelesen);
+    return fehler;
+}
+
+// "./main --atlas [datei]": Atlas für die Startauflösung erzeugen und prüfen.
+static int AtlasKommando(const char* datei, int width, int height) {
+    AtlasKopf kopf = {.width = width, .height = height, .lambdaMin = 10, .lambdaMax = 85,
+                      .gitterDMin = 0, .gitterDMax = 150, .winkelMin = 0, .winkelMax = 180};
+    InitThreads();
+    bool ok = AtlasErzeugen(datei, kopf);
+    Atlas geprueft = {0};
+    if (ok) ok = AtlasOeffnen(&geprueft, datei) && AtlasPruefen(&geprueft, 97) == 0;
+    AtlasSchliessen(&geprueft);
+    ShutdownThreads();
+    return ok ? 0 : 1;
+}
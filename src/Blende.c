@@ -0,0 +1,327 @@
+// Blende.c
+// Frei gemalte Blende statt der drei Wandrechtecke und ihr Fraunhofer-Fernfeld.
+// Die Maske hat blendeN Stützstellen über die Fensterhöhe. Ihr Spektrum F
+// (FFT mit vierfacher Nullauffüllung) hängt nur von der Maske ab: die schräge
+// Beleuchtung unter winkel verschiebt das Fernfeld nur, und lambda legt nur
+// fest, welcher Bin zu welchem Beugungswinkel gehört. Neu transformiert wird
+// deshalb nur nach einer Änderung an der Maske, und kleine Änderungen werden
+// als direkte DFT des Unterschieds auf F addiert.
+//
+// Ein auf das Fenster gezogenes Bild wird als 2D-Blende geladen und mit Fft2d
+// transformiert.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLENDE_N_MIN 256
+#define BLENDE_N_MAX 4096
+#define BLENDE_PAD 4                // Nullauffüllung: P = BLENDE_PAD * N
+#define BLENDE_STRIP 15             // Malbereich links und rechts der Wand
+#define BLENDE_PLOT 260             // Breite der Intensitätskurve in Pixeln
+
+typedef struct {
+    int n;                          // Stützstellen der Maske
+    int p;                          // FFT-Länge
+    float* maske;                   // Transmission 0..1
+    float* spektrumRe;
+    float* spektrumIm;
+    float* leistung;                // |F|², P Werte
+    float* drehRe;                  // exp(-2 pi i t / P), t in [0, P)
+    float* drehIm;
+
+    int height, gitterD;            // wofür die Standardmaske gebaut wurde
+    bool bemalt;                    // von Hand geändert, folgt nicht mehr gitterD
+    int version;                    // zählt jede Änderung der Maske
+
+    // 2D-Blende aus einem Bild
+    bool zweiD;
+    FeldBild bild2d;
+
+    double rechenzeit;
+    bool inkrementell;
+    int zuletztGeaendert;
+} Blende;
+
+static Blende blende = {0};
+static int blendeN = 1024;          // mit +/- einstellbar
+
+static void BlendeLeistung(Blende* b, int von, int bis) {
+    for (int m = von; m < bis; m++) {
+        b->leistung[m] = b->spektrumRe[m] * b->spektrumRe[m] + b->spektrumIm[m] * b->spektrumIm[m];
+    }
+}
+
+static void TransformBlende(Blende* b) {
+    memset(b->spektrumRe, 0, b->p * sizeof(float));
+    memset(b->spektrumIm, 0, b->p * sizeof(float));
+    memcpy(b->spektrumRe, b->maske, b->n * sizeof(float));
+    Fft(GetFftPlan(b->p), b->spektrumRe, b->spektrumIm, false);
+    BlendeLeistung(b, 0, b->p);
+    b->inkrementell = false;
+    b->version++;
+}
+
+// Die Stützstellen [von, bis) ändern sich von alt auf die aktuelle Maske.
+// Etwa 10 P Operationen pro Stützstelle gegen 5 P log2 P für die volle FFT.
+static void UpdateBlende(Blende* b, int von, int bis, const float* alt) {
+    int log2p = GetFftPlan(b->p)->log2n;
+    if ((bis - von) * 2 > log2p) {
+        TransformBlende(b);
+        return;
+    }
+
+    for (int j = von; j < bis; j++) {
+        float delta = b->maske[j] - alt[j - von];
+        if (delta == 0.0f) continue;
+
+        // F_m += delta * exp(-2 pi i m j / P), Exponent modulo P aus der Tabelle.
+        const int maske = b->p - 1;
+        float* restrict re = b->spektrumRe;
+        float* restrict im = b->spektrumIm;
+        const float* restrict dr = b->drehRe;
+        const float* restrict di = b->drehIm;
+        for (int m = 0; m < b->p; m++) {
+            int t = (m * j) & maske;
+            re[m] += delta * dr[t];
+            im[m] += delta * di[t];
+        }
+    }
+    BlendeLeistung(b, 0, b->p);
+    b->inkrementell = true;
+    b->version++;
+}
+
+// Baut die Standardmaske aus den Spalten. Eine bemalte Maske bleibt erhalten
+// und wird bei neuer Stützstellenzahl nur umgetastet.
+static void ResetBlende(Blende* b, int height, AppState* state) {
+    float* alt = NULL;
+    int altN = b->n;
+    if (b->n != blendeN) {
+        if (b->bemalt) alt = b->maske;
+        else free(b->maske);
+        free(b->spektrumRe);
+        free(b->spektrumIm);
+        free(b->leistung);
+        free(b->drehRe);
+        free(b->drehIm);
+        b->n = blendeN;
+        b->p = BLENDE_PAD * blendeN;
+        b->maske = malloc(b->n * sizeof(float));
+        b->spektrumRe = malloc(b->p * sizeof(float));
+        b->spektrumIm = malloc(b->p * sizeof(float));
+        b->leistung = malloc(b->p * sizeof(float));
+        b->drehRe = malloc(b->p * sizeof(float));
+        b->drehIm = malloc(b->p * sizeof(float));
+        for (int t = 0; t < b->p; t++) {
+            b->drehRe[t] = (float)cos(-2.0 * PI * t / b->p);
+            b->drehIm[t] = (float)sin(-2.0 * PI * t / b->p);
+        }
+    }
+
+    if (b->bemalt) {
+        for (int j = 0; alt && j < b->n; j++) b->maske[j] = alt[(int)((long)j * altN / b->n)];
+        free(alt);
+    } else {
+        Spalt s = SpaltGeometrie(0, height, state);
+        for (int j = 0; j < b->n; j++) {
+            float y = (j + 0.5f) * height / b->n;
+            b->maske[j] = IstWand(s, 0.0f, y) ? 0.0f : 1.0f;
+        }
+        b->gitterD = state->gitterD;
+    }
+
+    b->height = height;
+    b->zweiD = false;
+    TransformBlende(b);
+}
+
+static void MaleBlende(Blende* b, int width, int height) {
+    if (active_id >= 0) return;
+
+    bool offen = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    bool zu = IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
+    if (!offen && !zu) return;
+
+    Vector2 maus = GetMousePosition();
+    Vector2 vorher = Vector2Subtract(maus, GetMouseDelta());
+    int xSpalt = width / 3;
+    if (fabsf(maus.x - xSpalt) > BLENDE_STRIP || maus.y < 0 || maus.y >= height - PANEL_HOEHE) return;
+
+    // Zwischen zwei Bildern überstrichene Stützstellen mitnehmen.
+    float y0 = fminf(maus.y, vorher.y), y1 = fmaxf(maus.y, vorher.y);
+    if (fabsf(vorher.x - xSpalt) > BLENDE_STRIP) y0 = y1 = maus.y;
+    int von = (int)(y0 * b->n / height);
+    int bis = (int)(y1 * b->n / height) + 1;
+    if (von < 0) von = 0;
+    if (bis > b->n) bis = b->n;
+
+    float alt[BLENDE_N_MAX];
+    memcpy(alt, b->maske + von, (bis - von) * sizeof(float));
+    bool geaendert = false;
+    for (int j = von; j < bis; j++) {
+        float neu = offen ? 1.0f : 0.0f;
+        geaendert |= b->maske[j] != neu;
+        b->maske[j] = neu;
+    }
+    if (!geaendert) return;
+    b->bemalt = true;
+
+    double start = NowSeconds();
+    UpdateBlende(b, von, bis, alt);
+    b->rechenzeit = NowSeconds() - start;
+    b->zuletztGeaendert = bis - von;
+}
+
+static void LadeBlende2d(Blende* b, const char* datei, int width, int height) {
+    Image bild = LoadImage(datei);
+    if (bild.data == NULL) return;
+    ImageColorGrayscale(&bild);
+    ImageFormat(&bild, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+
+    // Bild mittig in ein doppelt so großes Zweierpotenz-Gitter legen.
+    int nx = 1, ny = 1;
+    while (nx < 2 * bild.width && nx < 2048) nx *= 2;
+    while (ny < 2 * bild.height && ny < 2048) ny *= 2;
+    size_t n = (size_t)nx * ny;
+    float* re = calloc(n, sizeof(float));
+    float* im = calloc(n, sizeof(float));
+
+    const unsigned char* grau = bild.data;
+    int bx = bild.width < nx ? bild.width : nx, by = bild.height < ny ? bild.height : ny;
+    for (int y = 0; y < by; y++) {
+        for (int x = 0; x < bx; x++) {
+            re[(size_t)(y + (ny - by) / 2) * nx + x + (nx - bx) / 2] = grau[(size_t)y * bild.width + x] / 255.0f;
+        }
+    }
+    UnloadImage(bild);
+
+    double start = NowSeconds();
+    Fft2d(re, im, nx, ny, false);
+    b->rechenzeit = NowSeconds() - start;
+
+    // log |F|², Nullfrequenz in die Mitte geschoben, auf die Feldfläche skaliert.
+    // Ein ganz schwarzes Bild hat kein Spektrum, dann bleibt alles schwarz.
+    float maxLog = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        re[i] = logf(1.0f + re[i] * re[i] + im[i] * im[i]);
+        if (re[i] > maxLog) maxLog = re[i];
+    }
+    if (maxLog <= 0.0f) maxLog = 1.0f;
+
+    int x0 = width / 3 + 3;
+    PrepareFeldBild(&b->bild2d, x0, width - x0, height);
+    for (int y = 0; y < height; y++) {
+        int fy = ((y * ny / height) + ny / 2) % ny;
+        for (int x = 0; x < b->bild2d.breite; x++) {
+            int fx = ((x * nx / b->bild2d.breite) + nx / 2) % nx;
+            unsigned char v = (unsigned char)(255.0f * re[(size_t)fy * nx + fx] / maxLog);
+            b->bild2d.pixels[(size_t)y * b->bild2d.breite + x] = (Color){v, v, v, 255};
+        }
+    }
+    UpdateTexture(b->bild2d.texture, b->bild2d.pixels);
+
+    free(re);
+    free(im);
+    b->zweiD = true;
+    b->version++;
+}
+
+// Intensität unter dem Beugungswinkel theta. Die einfallende Welle läuft in
+// Richtung (cos phi, -sin phi) und trägt an der Wand die Phase -k y sin phi;
+// Bin m liegt deshalb bei sin(theta) + sin(phi) = m lambda / (P dy).
+static float BlendeIntensitaet(Blende* b, float height, float lambda, float sinPhi, float sinTheta) {
+    float dy = height / b->n;
+    float bin = (sinTheta + sinPhi) * b->p * dy / lambda;
+    float m = floorf(bin);
+    float t = bin - m;
+    int i0 = ((int)m % b->p + b->p) % b->p;
+    int i1 = (i0 + 1) % b->p;
+    return b->leistung[i0] * (1.0f - t) + b->leistung[i1] * t;
+}
+
+void DrawBlende(int width, int height, AppState* state) {
+    Blende* b = &blende;
+
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        if (blendeN < BLENDE_N_MAX) blendeN *= 2;
+    }
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        if (blendeN > BLENDE_N_MIN) blendeN /= 2;
+    }
+
+    // Eine bemalte Maske hängt nur an der relativen Höhe; erst C verwirft sie.
+    if (IsKeyPressed(KEY_C)) b->bemalt = false;
+    if (b->bemalt && !b->zweiD) b->height = height;
+    if (b->n != blendeN || b->height != height || IsKeyPressed(KEY_C) ||
+        (b->gitterD != state->gitterD && !b->zweiD && !b->bemalt)) {
+        ResetBlende(b, height, state);
+    }
+
+    if (IsFileDropped()) {
+        FilePathList dateien = LoadDroppedFiles();
+        if (dateien.count > 0) LadeBlende2d(b, dateien.paths[0], width, height);
+        UnloadDroppedFiles(dateien);
+    }
+
+    if (b->zweiD) {
+        DrawFeldBild(&b->bild2d);
+        overlay_text(TextFormat("2D-Blende: Fernfeld in %.1f ms, C: zurück zur 1D-Blende", b->rechenzeit * 1000.0));
+        return;
+    }
+
+    MaleBlende(b, width, height);
+
+    // Fernfeld auf einem Schirm am rechten Rand: Helligkeit entlang der
+    // Strahlen aus der Blendenmitte und die Intensitätskurve am Schirm.
+    int xSpalt = width / 3;
+    float abstand = (float)(width - xSpalt);
+    float sinPhi = sinf((state->winkel - 90) * PI / 180.0f);
+    float maxI = 0.0f;
+    for (int i = 0; i < b->p; i++) maxI = fmaxf(maxI, b->leistung[i]);
+    if (maxI <= 0.0f) maxI = 1.0f;
+
+    Vector2 kurve[2] = {0};
+    for (int y = 0; y < height; y++) {
+        float dy = y + 0.5f - height / 2.0f;
+        float sinTheta = dy / sqrtf(dy * dy + abstand * abstand);
+        float intensitaet = BlendeIntensitaet(b, (float)height, (float)state->lambda, sinPhi, sinTheta) / maxI;
+
+        unsigned char v = (unsigned char)(255.0f * sqrtf(intensitaet));
+        DrawLine(width - BLENDE_PLOT - 40, y, width - BLENDE_PLOT - 10, y, (Color){v, 0, 0, 255});
+
+        kurve[1] = (Vector2){width - BLENDE_PLOT + intensitaet * (BLENDE_PLOT - 10), (float)y};
+        if (y > 0) DrawLineV(kurve[0], kurve[1], RED);
+        kurve[0] = kurve[1];
+    }
+
+    overlay_text(TextFormat("Blende %d Punkte%s, FFT %d [+/-], links/rechts malen, C: Spalte", b->n,
+                            b->bemalt ? " (bemalt)" : "", b->p));
+    overlay_text(TextFormat("Letzte Änderung: %d Punkte, %s, %.0f us", b->zuletztGeaendert,
+                            b->inkrementell ? "inkrementell" : "volle FFT", b->rechenzeit * 1e6));
+}
+
+// Zeichnet die Maske über die Wand aus DrawSinAndWall.
+void DrawBlendeWand(int width, int height) {
+    Blende* b = &blende;
+    if (b->zweiD || b->n == 0) return;
+
+    int xSpalt = width / 3;
+    for (int j = 0; j < b->n; j++) {
+        int y0 = j * height / b->n;
+        int y1 = (j + 1) * height / b->n;
+        Color c = b->maske[j] > 0.5f ? RAYWHITE : BLACK;
+        DrawRectangle(xSpalt - 2, y0, 5, y1 - y0, c);
+    }
+    DrawRectangleLines(xSpalt - BLENDE_STRIP, 0, 2 * BLENDE_STRIP, height, LIGHTGRAY);
+}
+
+void UnloadBlende(void) {
+    free(blende.maske);
+    free(blende.spektrumRe);
+    free(blende.spektrumIm);
+    free(blende.leistung);
+    free(blende.drehRe);
+    free(blende.drehIm);
+    FreeFeldBild(&blende.bild2d);
+    memset(&blende, 0, sizeof(blende));
+}
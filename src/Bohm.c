@@ -0,0 +1,182 @@
+// Bohm.c
+// Bohmsche Bahnen durch das Zwei-Quellen-Feld: jede Bahn folgt der Richtung
+// von Im(conj(psi) grad psi), integriert mit dem Mittelpunktsverfahren bei
+// fester Bogenlänge. Die Bahnen sind voneinander unabhängig und werden in
+// Gruppen zu BOHM_BATCH gleichzeitig gerechnet (die Schleife über eine Gruppe
+// wird vektorisiert), die Gruppen verteilt der Thread-Pool. Die Startpunkte
+// sind geschichtet mit Zufallsversatz gezogen (Monte Carlo über die Spalte).
+//
+// Gerechnet wird im Simulationsthread; jede Gruppe prüft alle
+// BOHM_PRUEFEN Schritte, ob der Auftrag inzwischen überholt ist.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rlgl.h"
+
+#define BOHM_BATCH 64
+#define BOHM_STEPS 1000
+#define BOHM_STORE_EVERY 4          // jeder vierte Schritt wird gezeichnet
+#define BOHM_POINTS (BOHM_STEPS / BOHM_STORE_EVERY + 1)
+#define BOHM_PRUEFEN 100            // Schritte zwischen zwei Abbruchprüfungen
+
+typedef struct {
+    int anzahl;                     // Bahnen
+    Vector2* punkte;                // kapazitaet * BOHM_POINTS, Bahn für Bahn
+    int kapazitaet;                 // auf ganze Gruppen aufgerundet
+
+    Quellen quellen;
+    float ds;
+    float xMin, xMax, yMax;
+
+    double rechenzeit;
+} Bohm;
+
+// Wählbare Bahnzahlen für +/-; 10000 ist die Zielgröße aus der Anforderung.
+static const int bohmStufen[] = {500, 1000, 2000, 5000, 10000, 16000};
+static int bohmAnzahl = 2000;
+
+// Richtung des Bohmschen Geschwindigkeitsfeldes an n Punkten.
+static inline void BohmRichtung(const Quellen* q, int n, const float* restrict x, const float* restrict y,
+                                float* restrict vx, float* restrict vy) {
+    for (int i = 0; i < n; i++) {
+        float dx = x[i] - q->x;
+        float dy1 = y[i] - q->y1;
+        float dy2 = y[i] - q->y2;
+        float r1 = sqrtf(dx * dx + dy1 * dy1) + 1e-3f;
+        float r2 = sqrtf(dx * dx + dy2 * dy2) + 1e-3f;
+        float inv1 = 1.0f / r1, inv2 = 1.0f / r2;
+        float a1 = sqrtf(inv1), a2 = sqrtf(inv2);
+
+        float t1 = q->k * (r1 - q->s1), t2 = q->k * (r2 - q->s2);
+        float c1 = a1 * FastCos(t1), s1 = a1 * FastSin(t1);
+        float c2 = a2 * FastCos(t2), s2 = a2 * FastSin(t2);
+
+        // psi = psi1 + psi2, d psi_j / d r_j = psi_j (ik - 1 / 2r_j)
+        float pr = c1 + c2, pi = s1 + s2;
+        float g1r = -0.5f * inv1 * c1 - q->k * s1, g1i = -0.5f * inv1 * s1 + q->k * c1;
+        float g2r = -0.5f * inv2 * c2 - q->k * s2, g2i = -0.5f * inv2 * s2 + q->k * c2;
+        float j1 = (pr * g1i - pi * g1r) * inv1;
+        float j2 = (pr * g2i - pi * g2r) * inv2;
+
+        float ux = j1 * dx + j2 * dx;
+        float uy = j1 * dy1 + j2 * dy2;
+        float norm = 1.0f / (sqrtf(ux * ux + uy * uy) + 1e-20f);
+        vx[i] = ux * norm;
+        vy[i] = uy * norm;
+    }
+}
+
+static void BohmGruppe(void* ctx, int begin, int end) {
+    Bohm* b = (Bohm*)ctx;
+    const Quellen* q = &b->quellen;
+    float x[BOHM_BATCH], y[BOHM_BATCH], xm[BOHM_BATCH], ym[BOHM_BATCH];
+    float vx[BOHM_BATCH], vy[BOHM_BATCH], schritt[BOHM_BATCH];
+
+    for (int g = begin; g < end; g++) {
+        int erste = g * BOHM_BATCH;
+
+        // Start auf kleinen Halbkreisen um die Spaltmitten, geschichtet über
+        // den Winkel; die beiden Spalte bekommen abwechselnd eine Bahn. Die
+        // letzte Gruppe rechnet bis zu BOHM_BATCH - 1 Bahnen zu viel, sie
+        // landen in der aufgerundeten Kapazität und werden nicht gezeichnet.
+        for (int i = 0; i < BOHM_BATCH; i++) {
+            int bahn = erste + i;
+            int proSpalt = b->anzahl / 2;
+            int k = bahn / 2;
+            unsigned int h = (unsigned int)bahn * 2654435761u;
+            float jitter = (float)(h >> 8) / 16777216.0f;
+            float theta = (-0.49f + 0.98f * (k + jitter) / proSpalt) * PI;
+            float r0 = 5.0f;
+            x[i] = q->x + r0 * cosf(theta);
+            y[i] = (bahn & 1 ? q->y2 : q->y1) + r0 * sinf(theta);
+            schritt[i] = b->ds;
+        }
+
+        for (int s = 0; s <= BOHM_STEPS; s++) {
+            if (s % BOHM_PRUEFEN == 0 && Abgebrochen()) return;
+            if (s % BOHM_STORE_EVERY == 0) {
+                int p = s / BOHM_STORE_EVERY;
+                for (int i = 0; i < BOHM_BATCH; i++) {
+                    b->punkte[(size_t)(erste + i) * BOHM_POINTS + p] = (Vector2){x[i], y[i]};
+                }
+            }
+            if (s == BOHM_STEPS) break;
+
+            BohmRichtung(q, BOHM_BATCH, x, y, vx, vy);
+            for (int i = 0; i < BOHM_BATCH; i++) {
+                xm[i] = x[i] + 0.5f * schritt[i] * vx[i];
+                ym[i] = y[i] + 0.5f * schritt[i] * vy[i];
+            }
+            BohmRichtung(q, BOHM_BATCH, xm, ym, vx, vy);
+            for (int i = 0; i < BOHM_BATCH; i++) {
+                x[i] += schritt[i] * vx[i];
+                y[i] += schritt[i] * vy[i];
+                // Bahnen, die das Feld verlassen, bleiben stehen.
+                bool drin = x[i] >= b->xMin && x[i] <= b->xMax && y[i] >= 0.0f && y[i] <= b->yMax;
+                schritt[i] = drin ? schritt[i] : 0.0f;
+            }
+        }
+    }
+}
+
+static void ComputeBohm(Bohm* b, int width, int height, AppState* state, int wunsch) {
+    int gruppen = (wunsch + BOHM_BATCH - 1) / BOHM_BATCH;
+    if (gruppen * BOHM_BATCH > b->kapazitaet) {
+        free(b->punkte);
+        b->kapazitaet = gruppen * BOHM_BATCH;
+        b->punkte = malloc((size_t)b->kapazitaet * BOHM_POINTS * sizeof(Vector2));
+    }
+    b->anzahl = wunsch;
+
+    Spalt s = SpaltGeometrie(width, height, state);
+    b->quellen = QuellenGeometrie(width, height, state);
+    b->xMin = (float)s.xSpalt;
+    b->xMax = (float)width;
+    b->yMax = (float)height;
+    b->ds = sqrtf((b->xMax - b->xMin) * (b->xMax - b->xMin) + b->yMax * b->yMax) / BOHM_STEPS;
+
+    double start = NowSeconds();
+    ParallelFor(gruppen, 1, BohmGruppe, b);
+    b->rechenzeit = NowSeconds() - start;
+}
+
+// Gewünschte Zahl der Bahnen, mit +/- eine Stufe aus bohmStufen weiter.
+static int BohmTasten(void) {
+    int n = sizeof(bohmStufen) / sizeof(bohmStufen[0]);
+    int i = 0;
+    while (i < n - 1 && bohmStufen[i] < bohmAnzahl) i++;
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        if (i < n - 1) i++;
+    }
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        if (i > 0) i--;
+    }
+    bohmAnzahl = bohmStufen[i];
+    return bohmAnzahl;
+}
+
+static void DrawBohm(const Bohm* b) {
+    // Alle Bahnen in einem einzigen Linien-Batch.
+    rlBegin(RL_LINES);
+    for (int t = 0; t < b->anzahl; t++) {
+        const Vector2* p = b->punkte + (size_t)t * BOHM_POINTS;
+        if (t & 1) rlColor4ub(190, 33, 55, 90);
+        else rlColor4ub(0, 82, 172, 90);
+
+        for (int i = 0; i + 1 < BOHM_POINTS; i++) {
+            if (p[i].x == p[i + 1].x && p[i].y == p[i + 1].y) break;
+            rlVertex2f(p[i].x, p[i].y);
+            rlVertex2f(p[i + 1].x, p[i + 1].y);
+        }
+    }
+    rlEnd();
+
+    overlay_text(TextFormat("Bohm: %d Bahnen x %d Schritte [+/-]: %.1f ms auf %d Threads",
+                            b->anzahl, BOHM_STEPS, b->rechenzeit * 1000.0, ThreadCount()));
+}
+
+static void FreeBohm(Bohm* b) {
+    free(b->punkte);
+    memset(b, 0, sizeof(*b));
+}
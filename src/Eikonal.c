@@ -0,0 +1,372 @@
+// Eikonal.c
+// Inhomogenes Medium rechts der Wand: eine malbare Brechzahlkarte n(x, y)
+// (Standard: Glasplatte hinter Spalt 1) und die optischen Weglängen L1, L2
+// von beiden Spalten als Lösung von |grad L| = n. Gelöst wird mit Fast
+// Sweeping (Godunov-Aufwindschema, vier Sweep-Richtungen im Wechsel), beide
+// Spalte in einem Durchgang, L1 und L2 liegen pro Zelle nebeneinander.
+//
+// Das Gitter wird in EIKONAL_BLOCK² großen Blöcken abgearbeitet. Innerhalb
+// eines Sweeps hängt ein Block nur von seinen stromaufwärts liegenden Nachbarn
+// ab, die Blöcke einer Blockdiagonale sind also unabhängig und laufen über den
+// Thread-Pool parallel, ohne die Gauß-Seidel-Reihenfolge zu ändern.
+//
+// Nach einer lokalen Änderung der Karte sind nur Zellen betroffen, deren
+// alter Wert mindestens das Minimum der alten Werte im geänderten Bereich
+// ist; nur diese werden zurückgesetzt und nur ihre Blöcke neu gesweept.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EIKONAL_BLOCK 64
+#define EIKONAL_UNENDLICH 1e30f     // endlich, damit a - b nie NaN wird
+#define EIKONAL_EPS 1e-3f           // kleinere Verbesserungen zählen als konvergiert
+#define EIKONAL_RUNDEN 16           // höchstens so viele Runden zu vier Sweeps
+#define EIKONAL_PINSEL 12           // Pinselradius in Pixel
+#define EIKONAL_PLATTE 60           // Dicke der Standardplatte in Pixel
+
+typedef struct {
+    int breite, hoehe;              // Gitter = Feldbereich aus FeldGeometrie
+    float* n;                       // Brechzahl je Zelle
+    float* l;                       // L1, L2 je Zelle
+    int blockeX, blockeY;
+    unsigned char* aktiv;           // Block darf sich ändern
+    int* stand;                     // letzter Sweep, in dem sich der Block verbessert hat
+    int sweep;                      // laufende Sweep-Nummer
+
+    float quelleX, quelleY[2];      // Spalte in Gitterkoordinaten
+
+    FeldGeometrie* geometrie;
+    FeldBild bild;
+    FeldStufen stufen;
+    float k, versatz;
+
+    int width, height, gitterD;
+    bool bemalt;                    // Karte von Hand geändert, folgt nicht mehr den Spalten
+    AppState gebaut;
+    bool neuZeichnen;
+
+    double rechenzeit;
+    int runden;
+    int zurueckgesetzt;             // Zellen beim letzten Lauf
+    bool inkrementell;
+} Eikonal;
+
+static Eikonal eikonal = {0};
+
+typedef struct {
+    Eikonal* e;
+    int sx, sy;                     // Sweep-Richtung
+    int diagonale;
+} EikonalSweep;
+
+static void EikonalBlock(Eikonal* e, int bx, int by, int sx, int sy) {
+    const int breite = e->breite, hoehe = e->hoehe;
+    int xa = bx * EIKONAL_BLOCK, ya = by * EIKONAL_BLOCK;
+    int xb = xa + EIKONAL_BLOCK < breite ? xa + EIKONAL_BLOCK : breite;
+    int yb = ya + EIKONAL_BLOCK < hoehe ? ya + EIKONAL_BLOCK : hoehe;
+    if (xa == 0) xa = 1;            // Spalte 0 ist Randwert
+    bool geaendert = false;
+
+    for (int jj = 0; jj < yb - ya; jj++) {
+        int y = sy > 0 ? ya + jj : yb - 1 - jj;
+        float* zeile = e->l + 2 * (size_t)y * breite;
+        const float* oben = y > 0 ? zeile - 2 * breite : NULL;
+        const float* unten = y + 1 < hoehe ? zeile + 2 * breite : NULL;
+        const float* n = e->n + (size_t)y * breite;
+
+        for (int ii = 0; ii < xb - xa; ii++) {
+            int x = sx > 0 ? xa + ii : xb - 1 - ii;
+            float f = n[x];
+            for (int c = 0; c < 2; c++) {
+                float a = zeile[2 * (x - 1) + c];
+                if (x + 1 < breite) a = fminf(a, zeile[2 * (x + 1) + c]);
+                float b = EIKONAL_UNENDLICH;
+                if (oben) b = oben[2 * x + c];
+                if (unten) b = fminf(b, unten[2 * x + c]);
+
+                float t;
+                if (fabsf(a - b) >= f) t = fminf(a, b) + f;
+                else t = 0.5f * (a + b + sqrtf(2.0f * f * f - (a - b) * (a - b)));
+
+                float* alt = &zeile[2 * x + c];
+                if (t < *alt - EIKONAL_EPS) geaendert = true;
+                if (t < *alt) *alt = t;
+            }
+        }
+    }
+    if (geaendert) e->stand[by * e->blockeX + bx] = e->sweep;
+}
+
+// Ein Block muss nur gesweept werden, wenn sich er selbst oder ein Nachbar
+// in einem der letzten vier Sweeps (einer aus jeder Richtung) verbessert hat.
+static bool EikonalNoetig(const Eikonal* e, int bx, int by) {
+    int b = by * e->blockeX + bx;
+    if (!e->aktiv[b]) return false;
+    int letzter = e->stand[b];
+    if (bx > 0 && e->stand[b - 1] > letzter) letzter = e->stand[b - 1];
+    if (bx + 1 < e->blockeX && e->stand[b + 1] > letzter) letzter = e->stand[b + 1];
+    if (by > 0 && e->stand[b - e->blockeX] > letzter) letzter = e->stand[b - e->blockeX];
+    if (by + 1 < e->blockeY && e->stand[b + e->blockeX] > letzter) letzter = e->stand[b + e->blockeX];
+    return letzter > e->sweep - 5;
+}
+
+static void EikonalDiagonale(void* ctx, int begin, int end) {
+    EikonalSweep* s = (EikonalSweep*)ctx;
+    Eikonal* e = s->e;
+    int bxVon = s->diagonale - (e->blockeY - 1) > 0 ? s->diagonale - (e->blockeY - 1) : 0;
+
+    for (int k = begin; k < end; k++) {
+        // Blockkoordinaten in Sweep-Reihenfolge, dann zurück ins Gitter.
+        int u = bxVon + k, v = s->diagonale - u;
+        int bx = s->sx > 0 ? u : e->blockeX - 1 - u;
+        int by = s->sy > 0 ? v : e->blockeY - 1 - v;
+        if (EikonalNoetig(e, bx, by)) EikonalBlock(e, bx, by, s->sx, s->sy);
+    }
+}
+
+static void EikonalSweepen(Eikonal* e) {
+    static const int richtung[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+    int bloecke = e->blockeX * e->blockeY;
+
+    // Alle aktiven Blöcke gelten als gerade geändert.
+    for (int b = 0; b < bloecke; b++) e->stand[b] = e->sweep;
+
+    for (e->runden = 0; e->runden < EIKONAL_RUNDEN;) {
+        int rundenBeginn = e->sweep;
+        for (int r = 0; r < 4; r++) {
+            e->sweep++;
+            EikonalSweep s = {e, richtung[r][0], richtung[r][1], 0};
+            for (s.diagonale = 0; s.diagonale < e->blockeX + e->blockeY - 1; s.diagonale++) {
+                int von = s.diagonale - (e->blockeY - 1) > 0 ? s.diagonale - (e->blockeY - 1) : 0;
+                int bis = s.diagonale < e->blockeX - 1 ? s.diagonale : e->blockeX - 1;
+                ParallelFor(bis - von + 1, 1, EikonalDiagonale, &s);
+            }
+        }
+        e->runden++;
+
+        bool weiter = false;
+        for (int b = 0; b < bloecke; b++) weiter |= e->stand[b] > rundenBeginn;
+        if (!weiter) break;
+    }
+}
+
+// Spalte 0 liegt eine halbe Wandbreite hinter den Spalten: dort gilt noch
+// die gerade Verbindung, gewichtet mit der Brechzahl der Zelle.
+static void EikonalRand(Eikonal* e) {
+    for (int y = 0; y < e->hoehe; y++) {
+        for (int c = 0; c < 2; c++) {
+            float dx = 0.5f - e->quelleX, dy = y + 0.5f - e->quelleY[c];
+            e->l[2 * (size_t)y * e->breite + c] = e->n[(size_t)y * e->breite] * sqrtf(dx * dx + dy * dy);
+        }
+    }
+}
+
+static void SolveEikonal(Eikonal* e) {
+    double start = NowSeconds();
+    size_t zellen = (size_t)e->breite * e->hoehe;
+    for (size_t i = 0; i < 2 * zellen; i++) e->l[i] = EIKONAL_UNENDLICH;
+    EikonalRand(e);
+    memset(e->aktiv, 1, e->blockeX * e->blockeY);
+
+    EikonalSweepen(e);
+    e->zurueckgesetzt = (int)zellen;
+    e->inkrementell = false;
+    e->rechenzeit = NowSeconds() - start;
+    e->neuZeichnen = true;
+}
+
+// Nach einer Änderung der Karte in [xa, xb) x [ya, yb).
+static void UpdateEikonal(Eikonal* e, int xa, int xb, int ya, int yb) {
+    double start = NowSeconds();
+    // Eine Zelle Rand dazu: deren Aufwindwerte hängen an den geänderten Zellen.
+    xa = xa > 0 ? xa - 1 : 0;
+    ya = ya > 0 ? ya - 1 : 0;
+    xb = xb < e->breite ? xb + 1 : e->breite;
+    yb = yb < e->hoehe ? yb + 1 : e->hoehe;
+
+    float schwelle[2] = {EIKONAL_UNENDLICH, EIKONAL_UNENDLICH};
+    for (int y = ya; y < yb; y++) {
+        for (int x = xa; x < xb; x++) {
+            for (int c = 0; c < 2; c++) {
+                schwelle[c] = fminf(schwelle[c], e->l[2 * ((size_t)y * e->breite + x) + c]);
+            }
+        }
+    }
+
+    memset(e->aktiv, 0, e->blockeX * e->blockeY);
+    int zurueckgesetzt = 0;
+    for (int y = 0; y < e->hoehe; y++) {
+        float* zeile = e->l + 2 * (size_t)y * e->breite;
+        for (int x = 1; x < e->breite; x++) {
+            bool weg = false;
+            for (int c = 0; c < 2; c++) {
+                if (zeile[2 * x + c] >= schwelle[c]) {
+                    zeile[2 * x + c] = EIKONAL_UNENDLICH;
+                    weg = true;
+                }
+            }
+            if (weg) {
+                e->aktiv[(y / EIKONAL_BLOCK) * e->blockeX + x / EIKONAL_BLOCK] = 1;
+                zurueckgesetzt++;
+            }
+        }
+    }
+    if (xa == 0) EikonalRand(e);
+
+    EikonalSweepen(e);
+    e->zurueckgesetzt = zurueckgesetzt;
+    e->inkrementell = true;
+    e->rechenzeit = NowSeconds() - start;
+    e->neuZeichnen = true;
+}
+
+static void EikonalStandardKarte(Eikonal* e, AppState* state) {
+    for (size_t i = 0; i < (size_t)e->breite * e->hoehe; i++) e->n[i] = 1.0f;
+
+    // Glasplatte hinter Spalt 1 bis zur Mitte zwischen den Spalten.
+    int yMitte = (int)(0.5f * (e->quelleY[0] + e->quelleY[1]));
+    int ya = (int)e->quelleY[0] - 40 > 0 ? (int)e->quelleY[0] - 40 : 0;
+    int yb = state->gitterD > 0 ? yMitte : (int)e->quelleY[0] + 40;
+    int xb = EIKONAL_PLATTE < e->breite ? EIKONAL_PLATTE : e->breite;
+    for (int y = ya; y < yb; y++) {
+        for (int x = 0; x < xb; x++) e->n[(size_t)y * e->breite + x] = 1.5f;
+    }
+}
+
+static void ResetEikonal(Eikonal* e, int width, int height, AppState* state) {
+    FeldGeometrie* g = GetFeldGeometrie(width, height, state);
+    bool neuesGitter = e->breite != g->breite || e->hoehe != g->hoehe;
+
+    if (neuesGitter) {
+        free(e->n);
+        free(e->l);
+        free(e->aktiv);
+        free(e->stand);
+        e->breite = g->breite;
+        e->hoehe = g->hoehe;
+        e->n = malloc((size_t)e->breite * e->hoehe * sizeof(float));
+        e->l = malloc(2 * (size_t)e->breite * e->hoehe * sizeof(float));
+        e->blockeX = (e->breite + EIKONAL_BLOCK - 1) / EIKONAL_BLOCK;
+        e->blockeY = (e->hoehe + EIKONAL_BLOCK - 1) / EIKONAL_BLOCK;
+        e->aktiv = malloc(e->blockeX * e->blockeY);
+        e->stand = malloc(e->blockeX * e->blockeY * sizeof(int));
+    }
+
+    e->geometrie = g;
+    e->quelleX = (float)(g->spalt.xSpalt - g->x0);
+    e->quelleY[0] = (float)g->spalt.ySpalt1;
+    e->quelleY[1] = (float)g->spalt.ySpalt2;
+    // Die Standardplatte wandert mit den Spalten, eine bemalte Karte bleibt
+    // stehen, bis C sie verwirft oder das Gitter neu angelegt wird.
+    if (neuesGitter || !e->bemalt) {
+        EikonalStandardKarte(e, state);
+        e->bemalt = false;
+    }
+
+    e->width = width;
+    e->height = height;
+    e->gitterD = state->gitterD;
+}
+
+static void MaleEikonal(Eikonal* e, float nPinsel) {
+    if (active_id >= 0) return;
+
+    bool glas = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    bool luft = IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
+    if (!glas && !luft) return;
+
+    Vector2 maus = GetMousePosition();
+    Vector2 vorher = Vector2Subtract(maus, GetMouseDelta());
+    if (maus.y >= e->height - PANEL_HOEHE) return;
+    float neu = glas ? nPinsel : 1.0f;
+    float x0 = (float)e->geometrie->x0;
+
+    // Die Strecke seit dem letzten Bild in Schritten von einem halben Radius stempeln.
+    float laenge = Vector2Distance(maus, vorher);
+    int schritte = 1 + (int)(laenge / (0.5f * EIKONAL_PINSEL));
+    int xa = e->breite, xb = 0, ya = e->hoehe, yb = 0;
+    bool geaendert = false;
+    for (int s = 0; s < schritte; s++) {
+        Vector2 p = Vector2Lerp(vorher, maus, (float)(s + 1) / schritte);
+        int cx = (int)(p.x - x0), cy = (int)p.y;
+        for (int y = cy - EIKONAL_PINSEL; y <= cy + EIKONAL_PINSEL; y++) {
+            if (y < 0 || y >= e->hoehe) continue;
+            for (int x = cx - EIKONAL_PINSEL; x <= cx + EIKONAL_PINSEL; x++) {
+                if (x < 0 || x >= e->breite) continue;
+                if ((x - cx) * (x - cx) + (y - cy) * (y - cy) > EIKONAL_PINSEL * EIKONAL_PINSEL) continue;
+                float* zelle = &e->n[(size_t)y * e->breite + x];
+                if (*zelle == neu) continue;
+                *zelle = neu;
+                geaendert = true;
+                xa = x < xa ? x : xa;
+                xb = x + 1 > xb ? x + 1 : xb;
+                ya = y < ya ? y : ya;
+                yb = y + 1 > yb ? y + 1 : yb;
+            }
+        }
+    }
+    if (!geaendert) return;
+    e->bemalt = true;
+    UpdateEikonal(e, xa, xb, ya, yb);
+}
+
+static void EikonalKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Eikonal* e = (Eikonal*)ctx;
+    const FeldGeometrie* g = e->geometrie;
+    const float* r1 = g->r1 + (size_t)y * g->breite;
+    const float* r2 = g->r2 + (size_t)y * g->breite;
+    const float* l = e->l + 2 * (size_t)y * e->breite;
+    const float* n = e->n + (size_t)y * e->breite;
+
+    for (int x = x0; x < x1; x++) {
+        // Amplituden wie bei Kugelwellen aus den geometrischen Abständen.
+        float a1 = 1.0f / sqrtf(r1[x]), a2 = 1.0f / sqrtf(r2[x]);
+        float c = FastCos(e->k * (l[2 * x] - l[2 * x + 1]) + e->versatz);
+        float v = (a1 * a1 + a2 * a2 + 2.0f * a1 * a2 * c) / ((a1 + a2) * (a1 + a2));
+        unsigned char s = LinearToSrgb(v);
+        if (n[x] != 1.0f) out[x - x0] = (Color){(unsigned char)(0.7f * s), (unsigned char)(0.85f * s), s, 255};
+        else out[x - x0] = (Color){s, s, s, 255};
+    }
+}
+
+void DrawEikonal(int width, int height, AppState* state, float nPinsel) {
+    Eikonal* e = &eikonal;
+
+    if (e->width != width || e->height != height || e->gitterD != state->gitterD) {
+        ResetEikonal(e, width, height, state);
+        SolveEikonal(e);
+    }
+    if (IsKeyPressed(KEY_C)) {
+        EikonalStandardKarte(e, state);
+        e->bemalt = false;
+        SolveEikonal(e);
+    }
+    MaleEikonal(e, nPinsel);
+
+    if (e->neuZeichnen || e->gebaut.lambda != state->lambda || e->gebaut.winkel != state->winkel) {
+        double phi = (state->winkel - 90) * PI / 180.0;
+        e->k = (float)(2.0 * PI / state->lambda);
+        e->versatz = (float)(e->k * state->gitterD * sin(phi));
+        PrepareFeldBild(&e->bild, e->geometrie->x0, e->geometrie->breite, e->geometrie->hoehe);
+        FeldStufenStarten(&e->stufen, &e->bild, EikonalKernel, e);
+        e->gebaut = *state;
+        e->neuZeichnen = false;
+    }
+
+    DrawFeldStufen(&e->stufen, active_id >= 0 || IsMouseButtonDown(MOUSE_BUTTON_LEFT));
+    overlay_text(TextFormat("Eikonal %dx%d%s: links malen (n = %.2f), rechts Luft, C: Platte", e->breite,
+                            e->hoehe, e->bemalt ? " (bemalt)" : "", nPinsel));
+    overlay_text(TextFormat("%s: %d Zellen, %d Runden, %.1f ms", e->inkrementell ? "inkrementell" : "voll",
+                            e->zurueckgesetzt, e->runden, e->rechenzeit * 1000.0));
+}
+
+void UnloadEikonal(void) {
+    Eikonal* e = &eikonal;
+    free(e->n);
+    free(e->l);
+    free(e->aktiv);
+    free(e->stand);
+    FreeFeldStufen(&e->stufen);
+    FreeFeldBild(&e->bild);
+    memset(e, 0, sizeof(*e));
+}
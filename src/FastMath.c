@@ -0,0 +1,82 @@
+// FastMath.c
+// Sinus und Kosinus in float ohne Verzweigungen, damit der Compiler Schleifen
+// darüber vektorisieren kann (libm-Aufrufe verhindern das). Reduktion auf
+// [-pi/4, pi/4] nach Cody-Waite, danach Minimax-Polynome; der Fehler bleibt
+// bis |x| ~ 1e3 unter 1e-6. Dazu ein ebenso verzweigungsfreies atan2.
+#ifndef FASTMATH_C_
+#define FASTMATH_C_
+
+#include <math.h>
+
+#define FAST_2_PI 0.63661977236758134f
+#define FAST_PI_2_HI 1.5703125f
+#define FAST_PI_2_LO 4.83826794897e-4f
+#define FAST_ROUND 12582912.0f       // 1.5 * 2^23: Addition rundet auf ganze Zahl
+
+static inline float FastSinPoly(float r) {
+    float r2 = r * r;
+    return r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+}
+
+static inline float FastCosPoly(float r) {
+    float r2 = r * r;
+    return 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+}
+
+static inline float FastSin(float x) {
+    float qf = (x * FAST_2_PI + FAST_ROUND) - FAST_ROUND;
+    int q = (int)qf;
+    float r = (x - qf * FAST_PI_2_HI) - qf * FAST_PI_2_LO;
+    float s = FastSinPoly(r), c = FastCosPoly(r);
+    float ungerade = (float)(q & 1);
+    float v = s + ungerade * (c - s);
+    return v * (1.0f - (float)(q & 2));
+}
+
+static inline float FastCos(float x) {
+    float qf = (x * FAST_2_PI + FAST_ROUND) - FAST_ROUND;
+    int q = (int)qf;
+    float r = (x - qf * FAST_PI_2_HI) - qf * FAST_PI_2_LO;
+    float s = FastSinPoly(r), c = FastCosPoly(r);
+    float ungerade = (float)(q & 1);
+    float v = c + ungerade * (s - c);
+    return v * (1.0f - (float)((q + 1) & 2));
+}
+
+// Beide mit einer gemeinsamen Reduktion.
+static inline void FastSinCos(float x, float* s, float* c) {
+    float qf = (x * FAST_2_PI + FAST_ROUND) - FAST_ROUND;
+    int q = (int)qf;
+    float r = (x - qf * FAST_PI_2_HI) - qf * FAST_PI_2_LO;
+    float ps = FastSinPoly(r), pc = FastCosPoly(r);
+    float ungerade = (float)(q & 1);
+    *s = (ps + ungerade * (pc - ps)) * (1.0f - (float)(q & 2));
+    *c = (pc + ungerade * (ps - pc)) * (1.0f - (float)((q + 1) & 2));
+}
+
+// atan2 mit Ergebnis in [-pi, pi], ganz ohne Auswahl: Minimum und Maximum
+// der Beträge über |ax - ay|, atan des Quotienten in [0, 1] als Polynom in
+// z = t² (Tschebyschow-Interpolation, Fehler unter 4e-7), die Spiegelungen an
+// pi/4 und pi/2 über copysign. Mit ?: wanderten die Rechnungen in Zweige,
+// und GCC vektorisiert die Schleife nicht mehr.
+static inline float FastAtan2(float y, float x) {
+    float ax = fabsf(x), ay = fabsf(y);
+    float abstand = fabsf(ax - ay);
+    float klein = 0.5f * (ax + ay - abstand), gross = 0.5f * (ax + ay + abstand);
+    float t = klein / (gross + 1e-30f);
+    float z = t * t;
+    float p = -4.559792113e-03f;
+    p = p * z + 2.378051914e-02f;
+    p = p * z - 5.882975459e-02f;
+    p = p * z + 9.868865460e-02f;
+    p = p * z - 1.400329024e-01f;
+    p = p * z + 1.996696144e-01f;
+    p = p * z - 3.333181143e-01f;
+    p = p * z + 9.999998808e-01f;
+    float r = t * p;
+    r = 0.78539816f + copysignf(1.0f, ax - ay) * (r - 0.78539816f);     // |y| > |x|: pi/2 - r
+    r = 1.57079633f + copysignf(1.0f, x) * (r - 1.57079633f);          // x < 0: pi - r
+    return copysignf(r, y);
+}
+
+#endif // FASTMATH_C_
@@ -0,0 +1,270 @@
+// Fdtd.c
+// Ripple-Tank: löst die skalare 2D-Wellengleichung u_tt = c² Δu auf einem
+// Gitter über dem ganzen Fenster. Wand und Spalte kommen aus SpaltGeometrie,
+// die Quelle ist die ebene Welle unter state->winkel, die Ränder absorbieren
+// nach Mur (erste Ordnung).
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FDTD_GRID 1024              // Zellen entlang der kürzeren Fensterkante
+#define FDTD_COURANT 0.5f           // c * dt / dx, stabil bis 1/sqrt(2)
+#define FDTD_BUDGET_MS 12.0         // Rechenzeit je Frame, Rest für Bild und Textur
+#define FDTD_MAX_STEPS 128          // Schritte je Frame höchstens
+#define FDTD_TILE_X 256             // Spaltenblock: drei Zeilen davon passen in L1
+#define FDTD_BAND 16                // Zeilen pro Auftrag an den Thread-Pool
+#define FDTD_BYTES_PER_CELL 16      // u lesen, uAlt lesen+schreiben, Maske lesen
+#define FDTD_ZIEL 1000              // Schritte/s, Zielwert der Anforderung
+
+typedef struct {
+    int nx, ny;
+    float cell;                     // Pixel pro Zelle
+    float* u;                       // Zeitschritt n
+    float* uAlt;                    // Zeitschritt n-1, wird in-place zu n+1
+    float* offen;                   // 1.0 im Feld, 0.0 in der Wand
+    int xWand;                      // erste Zellspalte der Wand
+    long long schritt;
+
+    int width, height, gitterD;     // wofür Gitter und Maske gebaut sind
+
+    Color* pixels;
+    Texture2D texture;
+    float gainRechts;               // Anzeigeverstärkung hinter der Wand
+    float* maxRechts;               // je Band
+
+    double rechenzeit;              // gleitender Mittelwert pro Schritt
+    int schritteProFrame;
+    double messStart;               // tatsächliche Rate über Messfenster
+    long long messSchritt;
+    double schritteProSekunde;
+} Fdtd;
+
+static Fdtd fdtd = {0};
+
+static void FreeFdtd(Fdtd* f) {
+    free(f->u);
+    free(f->uAlt);
+    free(f->offen);
+    free(f->pixels);
+    free(f->maxRechts);
+    if (f->texture.id != 0) UnloadTexture(f->texture);
+    memset(f, 0, sizeof(*f));
+}
+
+static void BuildFdtdMask(Fdtd* f, int width, int height, AppState* state) {
+    Spalt s = SpaltGeometrie(width, height, state);
+    f->xWand = (int)((s.xSpalt - 2) / f->cell);
+
+    for (int y = 0; y < f->ny; y++) {
+        for (int x = 0; x < f->nx; x++) {
+            bool wand = IstWand(s, (x + 0.5f) * f->cell, (y + 0.5f) * f->cell);
+            f->offen[y * f->nx + x] = wand ? 0.0f : 1.0f;
+        }
+    }
+}
+
+static void PrepareFdtd(Fdtd* f, int width, int height, AppState* state) {
+    if (f->width != width || f->height != height) {
+        FreeFdtd(f);
+
+        f->cell = (float)(width < height ? width : height) / FDTD_GRID;
+        f->nx = (int)(width / f->cell);
+        f->ny = (int)(height / f->cell);
+        size_t n = (size_t)f->nx * f->ny;
+
+        f->u = calloc(n, sizeof(float));
+        f->uAlt = calloc(n, sizeof(float));
+        f->offen = malloc(n * sizeof(float));
+        f->pixels = malloc(n * sizeof(Color));
+        f->maxRechts = calloc((size_t)f->ny / FDTD_BAND + 1, sizeof(float));
+
+        Image image = GenImageColor(f->nx, f->ny, BLANK);
+        f->texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+
+        f->width = width;
+        f->height = height;
+        f->gitterD = -1;
+    }
+
+    if (f->gitterD != state->gitterD) {
+        BuildFdtdMask(f, width, height, state);
+        f->gitterD = state->gitterD;
+    }
+}
+
+// Innere Zellen der Zeilen [begin, end): uAlt = 2u - uAlt + C² Δu, in der
+// Wand 0. Spaltenblöcke halten die drei beteiligten Zeilen im L1-Cache, die
+// innere Schleife ist frei von Verzweigungen und wird vektorisiert.
+static void FdtdBand(void* ctx, int begin, int end) {
+    Fdtd* f = (Fdtd*)ctx;
+    const int nx = f->nx;
+    const float c2 = FDTD_COURANT * FDTD_COURANT;
+
+    if (begin < 1) begin = 1;
+    if (end > f->ny - 1) end = f->ny - 1;
+
+    for (int x0 = 1; x0 < nx - 1; x0 += FDTD_TILE_X) {
+        int x1 = x0 + FDTD_TILE_X < nx - 1 ? x0 + FDTD_TILE_X : nx - 1;
+
+        for (int y = begin; y < end; y++) {
+            const float* restrict c = f->u + (size_t)y * nx;
+            const float* restrict oben = c - nx;
+            const float* restrict unten = c + nx;
+            const float* restrict m = f->offen + (size_t)y * nx;
+            float* restrict p = f->uAlt + (size_t)y * nx;
+
+            for (int x = x0; x < x1; x++) {
+                float lap = c[x - 1] + c[x + 1] + oben[x] + unten[x] - 4.0f * c[x];
+                p[x] = m[x] * (2.0f * c[x] - p[x] + c2 * lap);
+            }
+        }
+    }
+}
+
+// Mur-Randbedingung erster Ordnung: next liegt in uAlt, u ist noch Schritt n.
+static void FdtdRaender(Fdtd* f) {
+    const int nx = f->nx, ny = f->ny;
+    const float k = (FDTD_COURANT - 1.0f) / (FDTD_COURANT + 1.0f);
+    float* u = f->u;
+    float* next = f->uAlt;
+
+    for (int y = 1; y < ny - 1; y++) {
+        float* c = u + (size_t)y * nx;
+        float* n = next + (size_t)y * nx;
+        n[0] = c[1] + k * (n[1] - c[0]);
+        n[nx - 1] = c[nx - 2] + k * (n[nx - 2] - c[nx - 1]);
+    }
+    for (int x = 0; x < nx; x++) {
+        next[x] = u[nx + x] + k * (next[nx + x] - u[x]);
+        size_t last = (size_t)(ny - 1) * nx;
+        next[last + x] = u[last - nx + x] + k * (next[last - nx + x] - u[last + x]);
+    }
+}
+
+// Weiche Linienquelle am linken Rand und am Rand, von dem die Welle kommt.
+// Die Phase folgt der Ausbreitungsrichtung (cos phi, -sin phi), sodass links
+// der Wand eine ebene Welle unter winkel entsteht.
+static void FdtdQuelle(Fdtd* f, AppState* state) {
+    double phi = (state->winkel - 90) * PI / 180.0;
+    double lambdaZellen = state->lambda / f->cell;
+    double k = 2.0 * PI / lambdaZellen;
+    double omega = k * FDTD_COURANT;
+    double t = (double)f->schritt;
+    double rampe = fmin(1.0, t * FDTD_COURANT / (3.0 * lambdaZellen));
+    float amp = (float)(omega * rampe);        // Wellenamplitude etwa 1
+
+    double yMitte = f->ny / 2.0;
+    double dx = cos(phi), dy = -sin(phi);
+
+    for (int y = 1; y < f->ny - 1; y++) {
+        double s = 2.0 * dx + (y - yMitte) * dy;
+        f->uAlt[(size_t)y * f->nx + 2] += amp * (float)sin(omega * t - k * s);
+    }
+
+    if (state->winkel == 90) return;
+
+    int y = state->winkel < 90 ? 2 : f->ny - 3;
+    for (int x = 3; x < f->xWand - 4; x++) {
+        double s = x * dx + (y - yMitte) * dy;
+        f->uAlt[(size_t)y * f->nx + x] += amp * (float)sin(omega * t - k * s);
+    }
+}
+
+static void StepFdtd(Fdtd* f, AppState* state) {
+    ParallelFor(f->ny, FDTD_BAND, FdtdBand, f);
+    FdtdRaender(f);
+    FdtdQuelle(f, state);
+
+    float* tmp = f->u;
+    f->u = f->uAlt;
+    f->uAlt = tmp;
+    f->schritt++;
+}
+
+// Hinter der Wand kommt nur ein Bruchteil der Welle an; dort wird mit dem
+// Maximum des letzten Bildes normiert, damit die Streifen sichtbar bleiben.
+static void FdtdPixels(void* ctx, int begin, int end) {
+    Fdtd* f = (Fdtd*)ctx;
+    float maxRechts = 0.0f;
+
+    for (int y = begin; y < end; y++) {
+        for (int x = 0; x < f->nx; x++) {
+            size_t i = (size_t)y * f->nx + x;
+            float v = f->u[i];
+            if (x > f->xWand) {
+                if (fabsf(v) > maxRechts) maxRechts = fabsf(v);
+                v *= f->gainRechts;
+            }
+            if (v > 1.0f) v = 1.0f;
+            if (v < -1.0f) v = -1.0f;
+
+            unsigned char a = (unsigned char)(255.0f * (1.0f - fabsf(v)));
+            Color c = v > 0.0f ? (Color){255, a, a, 255} : (Color){a, a, 255, 255};
+            if (f->offen[i] == 0.0f) c = BLACK;
+            f->pixels[i] = c;
+        }
+    }
+    f->maxRechts[begin / FDTD_BAND] = maxRechts;
+}
+
+// So viele Schritte, wie nach der gemessenen Zeit je Schritt in
+// FDTD_BUDGET_MS passen; die Simulation läuft damit nicht im Takt der
+// Bildrate, sondern so schnell, wie der Rechner es erlaubt.
+void DrawFdtd(int width, int height, AppState* state) {
+    Fdtd* f = &fdtd;
+    PrepareFdtd(f, width, height, state);
+
+    int schritte = f->rechenzeit > 0.0 ? (int)(FDTD_BUDGET_MS * 1e-3 / f->rechenzeit) : 1;
+    if (schritte < 1) schritte = 1;
+    if (schritte > FDTD_MAX_STEPS) schritte = FDTD_MAX_STEPS;
+    f->schritteProFrame = schritte;
+
+    double start = NowSeconds();
+    for (int i = 0; i < schritte; i++) StepFdtd(f, state);
+    double jetzt = NowSeconds();
+    double proSchritt = (jetzt - start) / schritte;
+    f->rechenzeit = f->rechenzeit == 0.0 ? proSchritt : 0.9 * f->rechenzeit + 0.1 * proSchritt;
+
+    // Tatsächlich gerechnete Schritte je Sekunde Wanduhr, über eine halbe
+    // Sekunde gemittelt; der Kehrwert der Rechenzeit ist nur die Spitze.
+    if (f->messStart == 0.0 || f->schritt < f->messSchritt) {
+        f->messStart = jetzt;
+        f->messSchritt = f->schritt;
+    } else if (jetzt - f->messStart >= 0.5) {
+        f->schritteProSekunde = (f->schritt - f->messSchritt) / (jetzt - f->messStart);
+        f->messStart = jetzt;
+        f->messSchritt = f->schritt;
+    }
+
+    float maxRechts = 0.0f;
+    for (int i = 0; i * FDTD_BAND < f->ny; i++) {
+        if (f->maxRechts[i] > maxRechts) maxRechts = f->maxRechts[i];
+    }
+    f->gainRechts = maxRechts > 1e-3f ? 1.0f / maxRechts : 1.0f;
+
+    ParallelFor(f->ny, FDTD_BAND, FdtdPixels, f);
+    UpdateTexture(f->texture, f->pixels);
+
+    Rectangle source = {0, 0, (float)f->nx, (float)f->ny};
+    Rectangle dest = {0, 0, f->nx * f->cell, f->ny * f->cell};
+    DrawTexturePro(f->texture, source, dest, (Vector2){0, 0}, 0.0f, WHITE);
+
+    double zellBytes = (double)f->nx * f->ny * FDTD_BYTES_PER_CELL;
+    double spitze = 1.0 / f->rechenzeit;
+    overlay_text(TextFormat("FDTD %dx%d, %d Threads: %.0f Schritte/s (%d je Frame), %.1f GB/s", f->nx, f->ny,
+                            ThreadCount(), f->schritteProSekunde, schritte,
+                            f->schritteProSekunde * zellBytes / 1e9));
+    overlay_text(TextFormat("  Spitze beim Rechnen: %.0f Schritte/s, %.1f GB/s", spitze, spitze * zellBytes / 1e9));
+    // Gemessen ist nur dieser Rechner; Zahlen für andere Kernzahlen gibt es nicht.
+    if (f->schritteProSekunde >= FDTD_ZIEL) {
+        overlay_text(TextFormat("  Ziel %d Schritte/s hier erreicht", FDTD_ZIEL));
+    } else if (f->schritteProSekunde > 0.0) {
+        overlay_text(TextFormat("  Ziel %d Schritte/s hier um Faktor %.1f verfehlt", FDTD_ZIEL,
+                                FDTD_ZIEL / f->schritteProSekunde));
+    }
+}
+
+void UnloadFdtd(void) {
+    FreeFdtd(&fdtd);
+}
@@ -0,0 +1,390 @@
+// Feld.c
+// Gemeinsame Grundlage der pixelweisen Feldmodi rechts der Wand:
+// - FeldGeometrie: r1, r2 für jedes Pixel, nur neu bei Größen- oder
+//   gitterD-Änderung, damit die Kerne nur noch Phasen rechnen. Der
+//   Render-Thread nutzt GetFeldGeometrie, der Simulationsthread eine eigene.
+// - FeldBild: Pixelpuffer samt Textur, in Kacheln parallel gefüllt.
+// - FeldStufen: dasselbe mit dynamischer Auflösung über mehrere Frames.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FELD_TILE 64
+
+typedef struct {
+    int x0;                         // erste Bildspalte (rechts der Wand)
+    int breite, hoehe;
+    float* r1;                      // Abstand zu Spalt 1, zeilenweise
+    float* r2;
+
+    Spalt spalt;
+    int width, height, gitterD;
+} FeldGeometrie;
+
+static FeldGeometrie feldGeometrie = {0};
+
+static void GeometrieZeilen(void* ctx, int begin, int end) {
+    FeldGeometrie* g = (FeldGeometrie*)ctx;
+    Spalt s = g->spalt;
+
+    for (int y = begin; y < end; y++) {
+        float dy1 = y + 0.5f - s.ySpalt1;
+        float dy2 = y + 0.5f - s.ySpalt2;
+        float* r1 = g->r1 + (size_t)y * g->breite;
+        float* r2 = g->r2 + (size_t)y * g->breite;
+        for (int i = 0; i < g->breite; i++) {
+            float dx = g->x0 + i + 0.5f - s.xSpalt;
+            r1[i] = sqrtf(dx * dx + dy1 * dy1);
+            r2[i] = sqrtf(dx * dx + dy2 * dy2);
+        }
+    }
+}
+
+static FeldGeometrie* FeldGeometrieAktualisieren(FeldGeometrie* g, int width, int height, AppState* state) {
+    if (g->width == width && g->height == height && g->gitterD == state->gitterD) return g;
+
+    Spalt s = SpaltGeometrie(width, height, state);
+    int x0 = s.xSpalt + 3;
+    int breite = width - x0;
+
+    if (g->width != width || g->height != height) {
+        free(g->r1);
+        free(g->r2);
+        g->r1 = malloc((size_t)breite * height * sizeof(float));
+        g->r2 = malloc((size_t)breite * height * sizeof(float));
+    }
+
+    g->spalt = s;
+    g->x0 = x0;
+    g->breite = breite;
+    g->hoehe = height;
+    g->width = width;
+    g->height = height;
+    g->gitterD = state->gitterD;
+
+    ParallelFor(height, 16, GeometrieZeilen, g);
+    return g;
+}
+
+static FeldGeometrie* GetFeldGeometrie(int width, int height, AppState* state) {
+    return FeldGeometrieAktualisieren(&feldGeometrie, width, height, state);
+}
+
+static void FeldGeometrieFreigeben(FeldGeometrie* g) {
+    free(g->r1);
+    free(g->r2);
+    memset(g, 0, sizeof(*g));
+}
+
+static void FreeFeldGeometrie(void) {
+    FeldGeometrieFreigeben(&feldGeometrie);
+}
+
+// Füllt out[0 .. x1 - x0) für Zeile y und die Bildspalten [x0, x1).
+typedef void (*FeldKernel)(void* ctx, int y, int x0, int x1, Color* out);
+
+typedef struct {
+    int x0;
+    int breite, hoehe;
+    Color* pixels;
+    Texture2D texture;
+} FeldBild;
+
+static void InitSrgbTabelle(void);
+
+static void PrepareFeldBild(FeldBild* b, int x0, int breite, int hoehe) {
+    InitSrgbTabelle();
+    if (b->breite == breite && b->hoehe == hoehe) {
+        b->x0 = x0;
+        return;
+    }
+
+    free(b->pixels);
+    if (b->texture.id != 0) UnloadTexture(b->texture);
+
+    b->x0 = x0;
+    b->breite = breite;
+    b->hoehe = hoehe;
+    b->pixels = malloc((size_t)breite * hoehe * sizeof(Color));
+
+    Image image = GenImageColor(breite, hoehe, BLANK);
+    b->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+}
+
+typedef struct {
+    Color* pixels;
+    int breite, hoehe;
+    FeldKernel kernel;
+    void* ctx;
+    int kachelnX;
+    int erste;                      // Kachelindex, bei dem der Bereich beginnt
+} FeldAuftrag;
+
+static void FeldKacheln(void* ctx, int begin, int end) {
+    FeldAuftrag* a = (FeldAuftrag*)ctx;
+
+    for (int t = begin + a->erste; t < end + a->erste; t++) {
+        int tx = (t % a->kachelnX) * FELD_TILE;
+        int ty = (t / a->kachelnX) * FELD_TILE;
+        int xe = tx + FELD_TILE < a->breite ? tx + FELD_TILE : a->breite;
+        int ye = ty + FELD_TILE < a->hoehe ? ty + FELD_TILE : a->hoehe;
+
+        for (int y = ty; y < ye; y++) {
+            a->kernel(a->ctx, y, tx, xe, a->pixels + (size_t)y * a->breite + tx);
+        }
+    }
+}
+
+// Nur die Pixel, ohne Textur: auch außerhalb des Render-Threads nutzbar,
+// wenn InitSrgbTabelle vorher gelaufen ist.
+static void FeldPixelFuellen(Color* pixels, int breite, int hoehe, FeldKernel kernel, void* ctx) {
+    FeldAuftrag a = {pixels, breite, hoehe, kernel, ctx, (breite + FELD_TILE - 1) / FELD_TILE, 0};
+    int kachelnY = (hoehe + FELD_TILE - 1) / FELD_TILE;
+    ParallelFor(a.kachelnX * kachelnY, 1, FeldKacheln, &a);
+}
+
+// Nur die Kachelzeilen [zeile0, zeile1), für stückweises Füllen über
+// mehrere Frames (Zeitscheibe.c).
+static void FeldKachelzeilenFuellen(Color* pixels, int breite, int hoehe, int zeile0, int zeile1, FeldKernel kernel,
+                                    void* ctx) {
+    int kachelnX = (breite + FELD_TILE - 1) / FELD_TILE;
+    FeldAuftrag a = {pixels, breite, hoehe, kernel, ctx, kachelnX, zeile0 * kachelnX};
+    ParallelFor(kachelnX * (zeile1 - zeile0), 1, FeldKacheln, &a);
+}
+
+static void FillFeldBild(FeldBild* b, FeldKernel kernel, void* ctx) {
+    FeldPixelFuellen(b->pixels, b->breite, b->hoehe, kernel, ctx);
+    UpdateTexture(b->texture, b->pixels);
+}
+
+static void DrawFeldBild(FeldBild* b) {
+    DrawTexture(b->texture, b->x0, 0, WHITE);
+}
+
+static void FreeFeldBild(FeldBild* b) {
+    free(b->pixels);
+    if (b->texture.id != 0) UnloadTexture(b->texture);
+    memset(b, 0, sizeof(*b));
+}
+
+// Dynamische Auflösung: das Bild wird in Stufen mit Schritt 4, 2 und 1
+// gefüllt, jede Stufe rechnet nur die Pixel, die die gröberen noch nicht
+// haben (jedes Pixel genau einmal). Angezeigt wird die feinste fertige Stufe;
+// die groben als kleine Textur mit bilinearer Filterung, hochskaliert. Beim
+// Ziehen eines Reglers wird nur bis Schritt 2 gerechnet, danach verfeinert
+// die Scheibenarbeit aus Zeitscheibe.c über einige Frames bis Schritt 1.
+#define FELD_STUFEN 3
+
+typedef struct {
+    FeldBild* bild;
+    FeldKernel kernel;
+    void* ctx;
+    Scheibenarbeit arbeit;          // Einheit: eine Zeile einer Stufe, grob zuerst
+    int zeilen[FELD_STUFEN + 1];    // erste Einheit jeder Stufe
+
+    int gezeigt;                    // angezeigte Stufe, -1: noch hochzuladen
+    Color* grob;
+    Texture2D grobTextur[FELD_STUFEN - 1];
+    int grobB[FELD_STUFEN - 1], grobH[FELD_STUFEN - 1];
+
+    long frame;
+    long pixel[FELD_STUFEN];        // im Frame frame gerechnet, je Stufe
+} FeldStufen;
+
+static int FeldStufenSchritt(int stufe) {
+    return 4 >> stufe;
+}
+
+// Rechnet Einheit u (bei rechnen == false nur zählen) und gibt die Zahl der
+// neuen Pixel zurück. Zeilen, die schon auf der gröberen Stufe lagen, haben
+// dort jedes zweite Pixel bekommen.
+static int FeldStufenZeile(const FeldStufen* f, int u, bool rechnen) {
+    int stufe = 0;
+    while (u >= f->zeilen[stufe + 1]) stufe++;
+    int schritt = FeldStufenSchritt(stufe);
+    int y = (u - f->zeilen[stufe]) * schritt;
+    int breite = f->bild->breite;
+    Color* zeile = f->bild->pixels + (size_t)y * breite;
+
+    int xStart = 0, xSchritt = schritt;
+    if (stufe > 0 && y % (2 * schritt) == 0) {
+        xStart = schritt;
+        xSchritt = 2 * schritt;
+    }
+    if (xStart >= breite) return 0;
+    int anzahl = (breite - 1 - xStart) / xSchritt + 1;
+    if (!rechnen) return anzahl;
+
+    if (xSchritt == 1) {
+        for (int x = 0; x < breite; x += FELD_TILE) {
+            int xe = x + FELD_TILE < breite ? x + FELD_TILE : breite;
+            f->kernel(f->ctx, y, x, xe, zeile + x);
+        }
+    } else {
+        for (int x = xStart; x < breite; x += xSchritt) f->kernel(f->ctx, y, x, x + 1, zeile + x);
+    }
+    return anzahl;
+}
+
+typedef struct {
+    FeldStufen* f;
+    int erste;
+} FeldStufenAuftrag;
+
+static void FeldStufenZeilen(void* ctx, int begin, int end) {
+    FeldStufenAuftrag* a = (FeldStufenAuftrag*)ctx;
+    for (int u = begin; u < end; u++) FeldStufenZeile(a->f, a->erste + u, true);
+}
+
+static void FeldStufenEinheiten(void* ctx, int begin, int end) {
+    FeldStufen* f = (FeldStufen*)ctx;
+    if (f->frame != zeitscheiben.frame) {
+        memset(f->pixel, 0, sizeof(f->pixel));
+        f->frame = zeitscheiben.frame;
+    }
+    for (int u = begin; u < end; u++) {
+        int stufe = 0;
+        while (u >= f->zeilen[stufe + 1]) stufe++;
+        f->pixel[stufe] += FeldStufenZeile(f, u, false);
+    }
+    FeldStufenAuftrag a = {f, begin};
+    ParallelFor(end - begin, 4, FeldStufenZeilen, &a);
+}
+
+// Statt FillFeldBild: fängt mit der gröbsten Stufe neu an. bild muss
+// vorbereitet sein, kernel und ctx bleiben bis zum nächsten Start gültig.
+static void FeldStufenStarten(FeldStufen* f, FeldBild* bild, FeldKernel kernel, void* ctx) {
+    f->bild = bild;
+    f->kernel = kernel;
+    f->ctx = ctx;
+    f->zeilen[0] = 0;
+    for (int stufe = 0; stufe < FELD_STUFEN; stufe++) {
+        int schritt = FeldStufenSchritt(stufe);
+        f->zeilen[stufe + 1] = f->zeilen[stufe] + (bild->hoehe + schritt - 1) / schritt;
+
+        if (stufe == FELD_STUFEN - 1) break;
+        int b = (bild->breite + schritt - 1) / schritt, h = (bild->hoehe + schritt - 1) / schritt;
+        if (f->grobB[stufe] != b || f->grobH[stufe] != h) {
+            if (f->grobTextur[stufe].id != 0) UnloadTexture(f->grobTextur[stufe]);
+            Image image = GenImageColor(b, h, BLANK);
+            f->grobTextur[stufe] = LoadTextureFromImage(image);
+            UnloadImage(image);
+            SetTextureFilter(f->grobTextur[stufe], TEXTURE_FILTER_BILINEAR);
+            f->grobB[stufe] = b;
+            f->grobH[stufe] = h;
+            if (stufe == FELD_STUFEN - 2) f->grob = realloc(f->grob, (size_t)b * h * sizeof(Color));
+        }
+    }
+    ScheibenarbeitStarten(&f->arbeit, f->zeilen[FELD_STUFEN], FeldStufenEinheiten, f);
+    f->gezeigt = -1;
+}
+
+// Rechnet weiter (die gröbste Stufe immer ganz, der Rest im Frame-Budget)
+// und zeichnet die feinste fertige Stufe.
+static void DrawFeldStufen(FeldStufen* f, bool interaktion) {
+    if (f->bild == NULL) return;
+    if (f->arbeit.fertig < f->zeilen[1]) {
+        double start = NowSeconds();
+        FeldStufenEinheiten(f, f->arbeit.fertig, f->zeilen[1]);
+        f->arbeit.fertig = f->zeilen[1];
+        zeitscheiben.verbraucht += NowSeconds() - start;
+    }
+    f->arbeit.gesamt = f->zeilen[interaktion ? FELD_STUFEN - 1 : FELD_STUFEN];
+    ScheibenarbeitWeiter(&f->arbeit);
+
+    int fertig = 0;
+    while (fertig + 1 < FELD_STUFEN && f->arbeit.fertig >= f->zeilen[fertig + 2]) fertig++;
+    FeldBild* b = f->bild;
+    if (fertig != f->gezeigt) {
+        if (fertig == FELD_STUFEN - 1) {
+            UpdateTexture(b->texture, b->pixels);
+        } else {
+            int schritt = FeldStufenSchritt(fertig), gb = f->grobB[fertig], gh = f->grobH[fertig];
+            for (int j = 0; j < gh; j++) {
+                const Color* zeile = b->pixels + (size_t)j * schritt * b->breite;
+                for (int i = 0; i < gb; i++) f->grob[(size_t)j * gb + i] = zeile[i * schritt];
+            }
+            UpdateTexture(f->grobTextur[fertig], f->grob);
+        }
+        f->gezeigt = fertig;
+    }
+
+    if (fertig == FELD_STUFEN - 1) {
+        DrawFeldBild(b);
+    } else {
+        // Texelmitten liegen bei (i + 0.5) * schritt, die Proben bei i * schritt + 0.5.
+        int schritt = FeldStufenSchritt(fertig);
+        float versatz = 0.5f * (schritt - 1);
+        Rectangle quelle = {0, 0, (float)f->grobB[fertig], (float)f->grobH[fertig]};
+        Rectangle ziel = {b->x0 - versatz, -versatz, (float)f->grobB[fertig] * schritt,
+                          (float)f->grobH[fertig] * schritt};
+        BeginScissorMode(b->x0, 0, b->breite, b->hoehe);
+        DrawTexturePro(f->grobTextur[fertig], quelle, ziel, (Vector2){0, 0}, 0.0f, WHITE);
+        EndScissorMode();
+    }
+
+    static const long keine[FELD_STUFEN] = {0};
+    const long* pixel = f->frame == zeitscheiben.frame ? f->pixel : keine;
+    overlay_text(TextFormat("Auflösung 1/%d%s, Pixel je Frame: 1/4 %ld, 1/2 %ld, 1/1 %ld",
+                            FeldStufenSchritt(fertig), interaktion ? " (Interaktion)" : "", pixel[0], pixel[1],
+                            pixel[2]));
+}
+
+static void FreeFeldStufen(FeldStufen* f) {
+    for (int stufe = 0; stufe < FELD_STUFEN - 1; stufe++) {
+        if (f->grobTextur[stufe].id != 0) UnloadTexture(f->grobTextur[stufe]);
+    }
+    free(f->grob);
+    memset(f, 0, sizeof(*f));
+}
+
+// Kleiner Vorrat an FeldBildern verschiedener Größe: wer zwischen wenigen
+// Auflösungen wechselt, bekommt Puffer und Textur wieder, statt neu anzulegen.
+#define FELD_POOL 4
+
+typedef struct {
+    FeldBild bilder[FELD_POOL];
+    int zuletzt[FELD_POOL];         // Zeitpunkt der letzten Ausgabe
+    int uhr;
+} FeldPool;
+
+static FeldBild* FeldBildAusPool(FeldPool* pool, int x0, int breite, int hoehe) {
+    int wahl = 0;
+    for (int i = 0; i < FELD_POOL; i++) {
+        FeldBild* b = &pool->bilder[i];
+        if (b->breite == breite && b->hoehe == hoehe) {
+            wahl = i;
+            break;
+        }
+        if (pool->zuletzt[i] < pool->zuletzt[wahl]) wahl = i;
+    }
+    PrepareFeldBild(&pool->bilder[wahl], x0, breite, hoehe);
+    pool->zuletzt[wahl] = ++pool->uhr;
+    return &pool->bilder[wahl];
+}
+
+static void FreeFeldPool(FeldPool* pool) {
+    for (int i = 0; i < FELD_POOL; i++) FreeFeldBild(&pool->bilder[i]);
+    memset(pool, 0, sizeof(*pool));
+}
+
+// sRGB-Kodierung über eine Tabelle, Eingabe linear in [0, 1].
+#define SRGB_LUT 4096
+
+static unsigned char srgbTabelle[SRGB_LUT + 1];
+
+static void InitSrgbTabelle(void) {
+    if (srgbTabelle[SRGB_LUT] != 0) return;
+    for (int i = 0; i <= SRGB_LUT; i++) {
+        double l = (double)i / SRGB_LUT;
+        double s = l <= 0.0031308 ? 12.92 * l : 1.055 * pow(l, 1.0 / 2.4) - 0.055;
+        srgbTabelle[i] = (unsigned char)(255.0 * s + 0.5);
+    }
+}
+
+static unsigned char LinearToSrgb(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 255;
+    return srgbTabelle[(int)(v * SRGB_LUT)];
+}
@@ -0,0 +1,302 @@
+// Feldabfrage.c
+// Batch-Abfrage des Zwei-Spalt-Feldes, siehe Feldabfrage.h. Das Feld ist
+// dasselbe wie in Bohm.c, psi = sum_j exp(i k (r_j - s_j)) / sqrt(r_j).
+// Die Punkte laufen in Blöcken zu FA_BLOCK durch einen Kern, der einmal für
+// AVX2/FMA, einmal für SSE2 und einmal ohne Vektorisierung übersetzt und beim
+// ersten Aufruf nach cpuid gewählt wird. Ab FA_PARALLEL Punkten teilt der
+// Thread-Pool die Arbeit in Stücke zu FA_STUECK Punkten auf. Solche großen
+// Aufträge laufen unter faSperre nacheinander; einen Pool, den erst
+// FeldAbfragen gestartet hat, hält FeldAbfrageBeenden wieder an.
+//
+// Im Programm wird die Datei wie alle Module in main.c eingebunden, sie lässt
+// sich aber auch allein übersetzen (gcc -O3 -fno-math-errno -c Feldabfrage.c,
+// gelinkt mit -lm -lpthread); nob baut daraus libfeldabfrage.a.
+#include "Feldabfrage.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FastMath.c"
+#include "Threads.c"
+
+#define FA_BLOCK 1024
+#define FA_STUECK (16 * FA_BLOCK)
+#define FA_PARALLEL (4 * FA_STUECK)
+#define FA_PI 3.14159265358979323846
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FA_X86 1
+#endif
+
+// Wie Quellen aus main.c, hier ohne raylib.
+typedef struct {
+    float x, y1, y2;
+    float k;
+    float s1, s2;
+} FaQuellen;
+
+// SpaltGeometrie und QuellenGeometrie aus main.c für FeldParameter.
+static FaQuellen FaQuellenVon(const FeldParameter* p) {
+    double phi = (p->winkel - 90) * FA_PI / 180.0;
+    double s0 = (double)p->gitterD / 2.0 * sin(phi);
+
+    FaQuellen q;
+    q.x = (float)(p->width / 3);
+    q.y1 = (float)((p->height - p->gitterD) / 2);
+    q.y2 = (float)((p->height + p->gitterD) / 2);
+    q.k = (float)(2.0 * FA_PI / p->lambda);
+    q.s1 = (float)-s0;
+    q.s2 = (float)s0;
+    return q;
+}
+
+typedef void (*FaStreckeFn)(const FaQuellen* q, size_t n, const float* x, const float* y, float* amplitude,
+                            float* phase, float* intensitaet);
+
+// Real- und Imaginärteil für n <= FA_BLOCK Punkte.
+static inline __attribute__((always_inline)) void FaBlock(const FaQuellen* q, int n, const float* restrict x,
+                                                          const float* restrict y, float* restrict re,
+                                                          float* restrict im) {
+    for (int i = 0; i < n; i++) {
+        float dx = x[i] - q->x;
+        float dy1 = y[i] - q->y1, dy2 = y[i] - q->y2;
+        float r1 = sqrtf(dx * dx + dy1 * dy1) + 1e-3f;
+        float r2 = sqrtf(dx * dx + dy2 * dy2) + 1e-3f;
+        float a1 = 1.0f / sqrtf(r1), a2 = 1.0f / sqrtf(r2);
+        float s1, c1, s2, c2;
+        FastSinCos(q->k * (r1 - q->s1), &s1, &c1);
+        FastSinCos(q->k * (r2 - q->s2), &s2, &c2);
+        re[i] = a1 * c1 + a2 * c2;
+        im[i] = a1 * s1 + a2 * s2;
+    }
+}
+
+static inline __attribute__((always_inline)) void FaStrecke(const FaQuellen* q, size_t n, const float* x,
+                                                            const float* y, float* amplitude, float* phase,
+                                                            float* intensitaet) {
+    float re[FA_BLOCK], im[FA_BLOCK];
+
+    for (size_t start = 0; start < n; start += FA_BLOCK) {
+        int m = n - start < FA_BLOCK ? (int)(n - start) : FA_BLOCK;
+        FaBlock(q, m, x + start, y + start, re, im);
+
+        if (intensitaet) {
+            float* restrict aus = intensitaet + start;
+            for (int i = 0; i < m; i++) aus[i] = re[i] * re[i] + im[i] * im[i];
+        }
+        if (amplitude) {
+            float* restrict aus = amplitude + start;
+            for (int i = 0; i < m; i++) aus[i] = sqrtf(re[i] * re[i] + im[i] * im[i]);
+        }
+        if (phase) {
+            float* restrict aus = phase + start;
+            for (int i = 0; i < m; i++) aus[i] = FastAtan2(im[i], re[i]);
+        }
+    }
+}
+
+#ifdef FA_X86
+__attribute__((target("avx2,fma"))) static void FaStreckeAvx2(const FaQuellen* q, size_t n, const float* x,
+                                                              const float* y, float* amplitude, float* phase,
+                                                              float* intensitaet) {
+    FaStrecke(q, n, x, y, amplitude, phase, intensitaet);
+}
+
+__attribute__((target("sse2"))) static void FaStreckeSse2(const FaQuellen* q, size_t n, const float* x,
+                                                          const float* y, float* amplitude, float* phase,
+                                                          float* intensitaet) {
+    FaStrecke(q, n, x, y, amplitude, phase, intensitaet);
+}
+#endif
+
+__attribute__((optimize("no-tree-vectorize"))) static void FaStreckeSkalar(const FaQuellen* q, size_t n,
+                                                                           const float* x, const float* y,
+                                                                           float* amplitude, float* phase,
+                                                                           float* intensitaet) {
+    FaStrecke(q, n, x, y, amplitude, phase, intensitaet);
+}
+
+static FaStreckeFn faStrecke = NULL;
+static const char* faStufe = "skalar";
+static pthread_once_t faEinmal = PTHREAD_ONCE_INIT;
+static pthread_mutex_t faSperre = PTHREAD_MUTEX_INITIALIZER;
+static bool faPoolEigen = false;    // Pool von FeldAbfragen gestartet, nicht von der App
+
+static void FaWaehlenEinmal(void) {
+    const char* wunsch = getenv("FELDABFRAGE_STUFE");
+    faStrecke = FaStreckeSkalar;
+    faStufe = "skalar";
+    if (wunsch && strcmp(wunsch, "skalar") == 0) return;
+
+#ifdef FA_X86
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse2")) return;
+    faStrecke = FaStreckeSse2;
+    faStufe = "sse2";
+    if (wunsch && strcmp(wunsch, "sse2") == 0) return;
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        faStrecke = FaStreckeAvx2;
+        faStufe = "avx2";
+    }
+#endif
+}
+
+static void FaWaehlen(void) {
+    pthread_once(&faEinmal, FaWaehlenEinmal);
+}
+
+typedef struct {
+    FaQuellen quellen;
+    size_t n;
+    const float* x;
+    const float* y;
+    float* amplitude;
+    float* phase;
+    float* intensitaet;
+} FaAuftrag;
+
+static float* FaVersetzt(float* feld, size_t start) {
+    return feld ? feld + start : NULL;
+}
+
+static void FaStuecke(void* ctx, int begin, int end) {
+    FaAuftrag* a = (FaAuftrag*)ctx;
+    for (int s = begin; s < end; s++) {
+        size_t start = (size_t)s * FA_STUECK;
+        size_t n = a->n - start < FA_STUECK ? a->n - start : FA_STUECK;
+        faStrecke(&a->quellen, n, a->x + start, a->y + start, FaVersetzt(a->amplitude, start),
+                  FaVersetzt(a->phase, start), FaVersetzt(a->intensitaet, start));
+    }
+}
+
+void FeldAbfragen(const FeldParameter* p, size_t n, const float* x, const float* y, float* amplitude, float* phase,
+                  float* intensitaet) {
+    FaWaehlen();
+    if (n == 0 || (!amplitude && !phase && !intensitaet)) return;
+
+    FaAuftrag a = {FaQuellenVon(p), n, x, y, amplitude, phase, intensitaet};
+    if (n < FA_PARALLEL) {
+        faStrecke(&a.quellen, n, x, y, amplitude, phase, intensitaet);
+        return;
+    }
+    pthread_mutex_lock(&faSperre);
+    if (!atomic_load(&pool.running)) {
+        InitThreads();
+        faPoolEigen = true;
+    }
+    ParallelFor((int)((n + FA_STUECK - 1) / FA_STUECK), 1, FaStuecke, &a);
+    pthread_mutex_unlock(&faSperre);
+}
+
+void FeldAbfrageBeenden(void) {
+    pthread_mutex_lock(&faSperre);
+    if (faPoolEigen) ShutdownThreads();
+    faPoolEigen = false;
+    pthread_mutex_unlock(&faSperre);
+}
+
+const char* FeldAbfrageStufe(void) {
+    FaWaehlen();
+    return faStufe;
+}
+
+// psi in double an denselben Punkten, als Maßstab für die float-Kerne;
+// zurück kommt |psi_1| + |psi_2|.
+static double FaReferenz(const FeldParameter* p, double x, double y, double* re, double* im) {
+    double phi = (p->winkel - 90) * FA_PI / 180.0;
+    double s0 = (double)p->gitterD / 2.0 * sin(phi);
+    double k = 2.0 * FA_PI / p->lambda;
+    double dx = x - p->width / 3;
+    double dy1 = y - (p->height - p->gitterD) / 2, dy2 = y - (p->height + p->gitterD) / 2;
+    double r1 = sqrt(dx * dx + dy1 * dy1) + 1e-3, r2 = sqrt(dx * dx + dy2 * dy2) + 1e-3;
+    double a1 = 1.0 / sqrt(r1), a2 = 1.0 / sqrt(r2);
+    *re = a1 * cos(k * (r1 + s0)) + a2 * cos(k * (r2 - s0));
+    *im = a1 * sin(k * (r1 + s0)) + a2 * sin(k * (r2 - s0));
+    return a1 + a2;
+}
+
+// Jeder Kern gegen die Referenz, gemessen an |psi_1| + |psi_2|: der Fehler
+// kommt vor allem aus r in float (eine Einheit der letzten Stelle bei 2000
+// Pixeln ist 1.2e-4 Pixel) und FastSinCos. Die Phase zählt nur, wo |psi|
+// nicht fast null ist.
+#define FA_PRUEF_PUNKTE (1 << 20)
+#define FA_PRUEF_TOLERANZ 1e-3
+
+long FeldAbfragePruefen(void) {
+    static const FeldParameter faelle[] = {
+        {10, 150, 45, 1728, 972}, {50, 75, 90, 1728, 972}, {85, 3, 170, 800, 600}, {23, 0, 0, 3840, 2160},
+    };
+    FaWaehlen();
+    struct {
+        const char* name;
+        FaStreckeFn fn;
+        bool da;
+    } stufen[] = {
+#ifdef FA_X86
+        {"avx2", FaStreckeAvx2, __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")},
+        {"sse2", FaStreckeSse2, __builtin_cpu_supports("sse2")},
+#endif
+        {"skalar", FaStreckeSkalar, true},
+    };
+    int nStufen = sizeof(stufen) / sizeof(stufen[0]);
+    float* x = malloc(FA_PRUEF_PUNKTE * sizeof(float));
+    float* y = malloc(FA_PRUEF_PUNKTE * sizeof(float));
+    float* amplitude = malloc(FA_PRUEF_PUNKTE * sizeof(float));
+    float* phase = malloc(FA_PRUEF_PUNKTE * sizeof(float));
+    float* intensitaet = malloc(FA_PRUEF_PUNKTE * sizeof(float));
+    double maxFehler[3] = {0}, dauer[3] = {0};
+    long fehler = 0;
+    unsigned int zufall = 12345;
+
+    for (int f = 0; f < (int)(sizeof(faelle) / sizeof(faelle[0])); f++) {
+        const FeldParameter* p = &faelle[f];
+        for (int i = 0; i < FA_PRUEF_PUNKTE; i++) {
+            zufall = zufall * 1664525u + 1013904223u;
+            x[i] = (float)((zufall >> 8) * (1.0 / (1 << 24)) * p->width);
+            zufall = zufall * 1664525u + 1013904223u;
+            y[i] = (float)((zufall >> 8) * (1.0 / (1 << 24)) * p->height);
+        }
+        FaQuellen q = FaQuellenVon(p);
+        for (int s = 0; s < nStufen; s++) {
+            if (!stufen[s].da) continue;
+            double start = NowSeconds();
+            stufen[s].fn(&q, FA_PRUEF_PUNKTE, x, y, amplitude, phase, intensitaet);
+            dauer[s] += NowSeconds() - start;
+
+            for (int i = 0; i < FA_PRUEF_PUNKTE; i += 7) {
+                double re, im;
+                double summe = FaReferenz(p, x[i], y[i], &re, &im);
+                double betrag = sqrt(re * re + im * im);
+                double dPhase = fabs(phase[i] - atan2(im, re));
+                if (dPhase > FA_PI) dPhase = 2.0 * FA_PI - dPhase;
+                double e = fmax(fabs(amplitude[i] - betrag), fabs(intensitaet[i] - betrag * betrag) / summe) / summe;
+                if (betrag > 1e-2 * summe) e = fmax(e, dPhase * betrag / summe);
+                if (!(e <= FA_PRUEF_TOLERANZ) && fehler++ < 10) {
+                    fprintf(stderr, "Feldabfrage %s: Fehler %.2e bei lambda %d, gitterD %d, winkel %d, (%.1f, %.1f)\n",
+                            stufen[s].name, e, p->lambda, p->gitterD, p->winkel, x[i], y[i]);
+                }
+                if (e > maxFehler[s]) maxFehler[s] = e;
+            }
+        }
+    }
+
+    int anzahl = (int)(sizeof(faelle) / sizeof(faelle[0]));
+    for (int s = 0; s < nStufen; s++) {
+        if (!stufen[s].da) {
+            printf("Feldabfrage %s: auf dieser CPU nicht verfügbar\n", stufen[s].name);
+            continue;
+        }
+        printf("Feldabfrage %s: größter Fehler %.1e, %.0f Mpts/s auf einem Thread\n", stufen[s].name, maxFehler[s],
+               anzahl * FA_PRUEF_PUNKTE / dauer[s] * 1e-6);
+    }
+    free(x);
+    free(y);
+    free(amplitude);
+    free(phase);
+    free(intensitaet);
+    return fehler;
+}
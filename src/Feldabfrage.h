@@ -0,0 +1,40 @@
+// Feldabfrage.h
+// C-Schnittstelle für externe Werkzeuge: das Zwei-Spalt-Feld der App an
+// beliebig vielen verstreuten Punkten (Sensoranordnungen, Zufallsproben).
+// Ein- und Ausgaben sind getrennte float-Felder (structure of arrays).
+#ifndef FELDABFRAGE_H_
+#define FELDABFRAGE_H_
+
+#include <stddef.h>
+
+// Dieselben Größen wie AppState und Fenster: daraus folgen Spaltposition,
+// Wellenzahl und Phasenversatz der beiden Quellen wie in der App.
+typedef struct {
+    int lambda;                     // Pixel
+    int gitterD;                    // Pixel
+    int winkel;                     // Grad, 90 = senkrechter Einfall
+    int width, height;              // Fenster, die Wand steht bei width / 3
+} FeldParameter;
+
+// Wertet psi an den n Punkten (x[i], y[i]) in Fensterpixeln aus. Jede der
+// drei Ausgaben darf NULL sein und wird dann nicht berechnet; die Felder
+// dürfen sich nicht überlappen. Phase in [-pi, pi]. Große Aufträge verteilt
+// ein Thread-Pool, der beim ersten solchen Auftrag startet. Aufrufe aus
+// mehreren Threads sind erlaubt; große laufen dabei nacheinander.
+void FeldAbfragen(const FeldParameter* p, size_t n, const float* x, const float* y,
+                  float* amplitude, float* phase, float* intensitaet);
+
+// Hält den Thread-Pool an, falls FeldAbfragen ihn gestartet hat. Danach
+// darf FeldAbfragen wieder aufgerufen werden und startet ihn neu.
+void FeldAbfrageBeenden(void);
+
+// Genutzter Kern: "avx2", "sse2" oder "skalar". Mit der Umgebungsvariable
+// FELDABFRAGE_STUFE lässt sich eine niedrigere Stufe erzwingen.
+const char* FeldAbfrageStufe(void);
+
+// Selbsttest: jede Stufe, die die CPU kann, an zufälligen Punkten gegen eine
+// Rechnung in double, mit Fehler und Mpts/s je Stufe auf stdout. Gibt die
+// Zahl der Punkte außerhalb der Toleranz zurück.
+long FeldAbfragePruefen(void);
+
+#endif // FELDABFRAGE_H_
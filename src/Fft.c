@@ -0,0 +1,183 @@
+// Fft.c
+// Eigene FFT ohne externe Bibliotheken: iterativer Radix-2-Algorithmus auf
+// getrennten Real-/Imaginärteil-Feldern, Pläne werden pro Größe gecacht.
+// Fft2d verteilt Zeilen und Spaltenblöcke auf den Thread-Pool.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FFT_MAX_LOG2 16             // größte Transformation: 65536 Punkte
+#define FFT_COLUMN_BLOCK 16         // Spalten, die zusammen umkopiert werden
+
+typedef struct {
+    int n;
+    int log2n;
+    int* bitrev;
+    // Drehfaktoren Stufe für Stufe hintereinander: die Stufe mit halber
+    // Länge h liegt ab Index h - 1 und ist damit in der Schleife zusammenhängend.
+    float* twRe;
+    float* twIm;
+} FftPlan;
+
+static FftPlan* fftPlans[FFT_MAX_LOG2 + 1] = {0};
+
+static bool IsPowerOfTwo(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+static FftPlan* GetFftPlan(int n) {
+    assert(IsPowerOfTwo(n));
+
+    int log2n = 0;
+    while ((1 << log2n) < n) log2n++;
+    assert(log2n <= FFT_MAX_LOG2);
+
+    if (fftPlans[log2n]) return fftPlans[log2n];
+
+    FftPlan* p = malloc(sizeof(FftPlan));
+    p->n = n;
+    p->log2n = log2n;
+    p->bitrev = malloc(n * sizeof(int));
+    p->twRe = malloc((n > 1 ? n - 1 : 1) * sizeof(float));
+    p->twIm = malloc((n > 1 ? n - 1 : 1) * sizeof(float));
+
+    for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < log2n; b++) {
+            if (i & (1 << b)) r |= 1 << (log2n - 1 - b);
+        }
+        p->bitrev[i] = r;
+    }
+
+    for (int h = 1; h < n; h *= 2) {
+        for (int j = 0; j < h; j++) {
+            double w = -PI * j / h;
+            p->twRe[h - 1 + j] = (float)cos(w);
+            p->twIm[h - 1 + j] = (float)sin(w);
+        }
+    }
+
+    fftPlans[log2n] = p;
+    return p;
+}
+
+static void FreeFftPlans(void) {
+    for (int i = 0; i <= FFT_MAX_LOG2; i++) {
+        if (!fftPlans[i]) continue;
+        free(fftPlans[i]->bitrev);
+        free(fftPlans[i]->twRe);
+        free(fftPlans[i]->twIm);
+        free(fftPlans[i]);
+        fftPlans[i] = NULL;
+    }
+}
+
+// In-place, unnormiert. inverse dreht nur das Vorzeichen des Exponenten.
+static void Fft(const FftPlan* p, float* restrict re, float* restrict im, bool inverse) {
+    const int n = p->n;
+
+    for (int i = 0; i < n; i++) {
+        int j = p->bitrev[i];
+        if (j > i) {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    const float s = inverse ? -1.0f : 1.0f;
+    for (int h = 1; h < n; h *= 2) {
+        const float* restrict wr = p->twRe + h - 1;
+        const float* restrict wi = p->twIm + h - 1;
+
+        for (int i = 0; i < n; i += 2 * h) {
+            float* restrict ar = re + i;
+            float* restrict ai = im + i;
+            float* restrict br = re + i + h;
+            float* restrict bi = im + i + h;
+
+            for (int j = 0; j < h; j++) {
+                float tr = br[j] * wr[j] - bi[j] * s * wi[j];
+                float ti = br[j] * s * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+}
+
+typedef struct {
+    float* re;
+    float* im;
+    int nx, ny;
+    bool inverse;
+} Fft2dJob;
+
+static void Fft2dRows(void* ctx, int begin, int end) {
+    Fft2dJob* job = (Fft2dJob*)ctx;
+    const FftPlan* p = GetFftPlan(job->nx);
+
+    for (int y = begin; y < end; y++) {
+        Fft(p, job->re + (size_t)y * job->nx, job->im + (size_t)y * job->nx, job->inverse);
+    }
+}
+
+// Spalten werden blockweise in einen zusammenhängenden Puffer kopiert, dort
+// transformiert und zurückgeschrieben; so liest jede Zeile ganze Cachezeilen.
+static void Fft2dColumns(void* ctx, int begin, int end) {
+    Fft2dJob* job = (Fft2dJob*)ctx;
+    const FftPlan* p = GetFftPlan(job->ny);
+    const int nx = job->nx, ny = job->ny;
+
+    static _Thread_local float* puffer = NULL;
+    static _Thread_local size_t pufferGroesse = 0;
+    size_t bedarf = (size_t)2 * FFT_COLUMN_BLOCK * ny;
+    if (pufferGroesse < bedarf) {
+        free(puffer);
+        puffer = malloc(bedarf * sizeof(float));
+        pufferGroesse = bedarf;
+    }
+
+    for (int b = begin; b < end; b++) {
+        int x0 = b * FFT_COLUMN_BLOCK;
+        int breite = x0 + FFT_COLUMN_BLOCK <= nx ? FFT_COLUMN_BLOCK : nx - x0;
+        float* re = puffer;
+        float* im = puffer + (size_t)FFT_COLUMN_BLOCK * ny;
+
+        for (int y = 0; y < ny; y++) {
+            const float* zr = job->re + (size_t)y * nx + x0;
+            const float* zi = job->im + (size_t)y * nx + x0;
+            for (int c = 0; c < breite; c++) {
+                re[(size_t)c * ny + y] = zr[c];
+                im[(size_t)c * ny + y] = zi[c];
+            }
+        }
+
+        for (int c = 0; c < breite; c++) {
+            Fft(p, re + (size_t)c * ny, im + (size_t)c * ny, job->inverse);
+        }
+
+        for (int y = 0; y < ny; y++) {
+            float* zr = job->re + (size_t)y * nx + x0;
+            float* zi = job->im + (size_t)y * nx + x0;
+            for (int c = 0; c < breite; c++) {
+                zr[c] = re[(size_t)c * ny + y];
+                zi[c] = im[(size_t)c * ny + y];
+            }
+        }
+    }
+}
+
+// 2D-Transformation eines zeilenweise gespeicherten nx*ny-Feldes, unnormiert.
+static void Fft2d(float* re, float* im, int nx, int ny, bool inverse) {
+    Fft2dJob job = {re, im, nx, ny, inverse};
+
+    // Pläne vorab anlegen, damit die Worker den Cache nur lesen.
+    GetFftPlan(nx);
+    GetFftPlan(ny);
+
+    ParallelFor(ny, 8, Fft2dRows, &job);
+    int bloecke = (nx + FFT_COLUMN_BLOCK - 1) / FFT_COLUMN_BLOCK;
+    ParallelFor(bloecke, 1, Fft2dColumns, &job);
+}
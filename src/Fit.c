@@ -0,0 +1,374 @@
+// Fit.c
+// Parameter aus einem Schirmbild: ein auf das Fenster gezogenes Graustufenbild
+// gilt als Aufnahme des Schirms am rechten Fensterrand, die Streifenachse
+// (Zeilen oder Spalten, je nachdem, wo sich mehr ändert) über die ganze
+// Fensterhöhe. Angepasst werden lambda, gitterD, winkel und die Spaltbreite w
+// samt Helligkeit A und Untergrund B an
+//   I(y) = A sinc²(pi w (sin theta + sin phi) / lambda) cos²(pi Delta / lambda) + B,
+//   Delta = r1 - r2 + d sin phi
+// mit den exakten Abständen r1, r2 von den Spalten zum Schirmpunkt.
+//
+// Alle Pixel einer Zeile quer zur Streifenachse teilen sich den Modellwert,
+// die Fehlerquadratsumme über alle Pixel ist deshalb bis auf eine Konstante
+// die gewichtete Summe über das Zeilenmittel. Residuen und Jacobi-Matrix
+// werden spaltenweise (SoA) in vektorisierbaren Schleifen gerechnet.
+// Levenberg-Marquardt startet von einem Gitter aus Startwerten, die Starts
+// verteilt der Thread-Pool, der beste gewinnt.
+//
+// Ohne bekannten Schirmabstand bestimmt ein Streifenbild im Wesentlichen nur
+// d / lambda und w / lambda. Ein schwacher Zusatzterm hält lambda deshalb
+// beim aktuellen Reglerwert, gitterD und w folgen im selben Maßstab.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIT_PARAMETER 6             // lambda, d, phi (Grad), w, A, B
+#define FIT_ITERATIONEN 100
+#define FIT_PRIOR 0.01              // Gewicht des lambda-Terms pro Stützstelle
+#define FIT_PLOT 260                // Breite der Kurven in Pixeln
+
+typedef struct {
+    double p[FIT_PARAMETER];
+    double kosten;
+    int iterationen;
+} FitLauf;
+
+typedef struct {
+    int m;                          // Stützstellen entlang der Streifenachse
+    float* profil;                  // Zeilenmittel, 0..1
+    float* y;                       // Schirmkoordinate je Stützstelle
+    int pixel;                      // Pixel im Bild
+
+    float hoehe, abstand;           // Fensterhöhe, Abstand Wand - Schirm
+    double lambda0;
+
+    FitLauf* laeufe;
+    int starts;
+    FitLauf bester;
+    float* modell;                  // bestes Modell zum Zeichnen
+
+    bool geladen, neu;
+    double rechenzeit;
+} Fit;
+
+static Fit fit = {0};
+
+typedef struct {
+    float lambda, d, w, a, b;
+    float sinPhi, cosPhi;
+    float y1, y2, yMitte, l, k;
+} FitKonstanten;
+
+// Modell und Ableitungen nach lambda, d, phi, w, A, B an m Stützstellen; jede
+// Ableitung als eigenes Feld, damit die Schleife ohne Alias-Prüfungen läuft.
+static void FitModellSpalten(const FitKonstanten* c, int m, const float* restrict ys, float* restrict modell,
+                             float* restrict jLambda, float* restrict jD, float* restrict jPhi,
+                             float* restrict jW, float* restrict jA, float* restrict jB) {
+    const float lambda = c->lambda, d = c->d, w = c->w, a = c->a, b = c->b;
+    const float sinPhi = c->sinPhi, cosPhi = c->cosPhi;
+    const float y1 = c->y1, y2 = c->y2, yMitte = c->yMitte, l = c->l, k = c->k;
+    const float grad = (float)(PI / 180.0);
+
+    for (int i = 0; i < m; i++) {
+        float u1 = ys[i] - y1, u2 = ys[i] - y2, u = ys[i] - yMitte;
+        float r1 = sqrtf(l * l + u1 * u1), r2 = sqrtf(l * l + u2 * u2);
+        float delta = r1 - r2 + d * sinPhi;
+
+        // cos²(pi Delta / lambda) = (1 + cos(k Delta)) / 2
+        float s2 = FastSin(k * delta), c2 = FastCos(k * delta);
+        float streifen = 0.5f + 0.5f * c2;
+        float dStreifen = -0.5f * k * s2;                   // nach Delta
+
+        // Einhüllende sinc²(beta). Für |beta| < 1e-2 die Reihe, als Auswahl
+        // ohne Sprung: dort verliert (bb cos bb - sin bb) / bb² in float zu
+        // viele Stellen, die abgebrochene Reihe liegt unter 1e-12 daneben.
+        float s = u / sqrtf(l * l + u * u) + sinPhi;
+        float beta = PI * w * s / lambda;
+        float b2 = beta * beta;
+        float klein = fabsf(beta) < 1e-2f ? 1.0f : 0.0f;
+        float bb = klein * 1e-2f + (1.0f - klein) * beta;
+        float sb = FastSin(bb), cb = FastCos(bb);
+        float sinc = klein * (1.0f - b2 / 6.0f + b2 * b2 / 120.0f) + (1.0f - klein) * sb / bb;
+        float dSinc = klein * beta * (b2 / 30.0f - 1.0f / 3.0f) + (1.0f - klein) * (bb * cb - sb) / (bb * bb);
+        float huelle = sinc * sinc;
+        float dHuelle = 2.0f * sinc * dSinc;                // nach beta
+
+        modell[i] = a * huelle * streifen + b;
+
+        float dDeltaDd = 0.5f * u1 / r1 + 0.5f * u2 / r2 + sinPhi;
+        jLambda[i] = a * (huelle * dStreifen * (-delta / lambda) + streifen * dHuelle * (-beta / lambda));
+        jD[i] = a * huelle * dStreifen * dDeltaDd;
+        jPhi[i] = a * grad * (huelle * dStreifen * d * cosPhi + streifen * dHuelle * PI * w * cosPhi / lambda);
+        jW[i] = a * streifen * dHuelle * PI * s / lambda;
+        jA[i] = huelle * streifen;
+        jB[i] = 1.0f;
+    }
+}
+
+// jac: FIT_PARAMETER Spalten zu je m Werten.
+static void FitModell(const Fit* f, const double* p, float* modell, float* jac) {
+    const int m = f->m;
+    float phi = (float)(p[2] * PI / 180.0);
+    FitKonstanten c = {(float)p[0], (float)p[1], (float)p[3], (float)p[4], (float)p[5], sinf(phi), cosf(phi),
+                       0.5f * (f->hoehe - (float)p[1]), 0.5f * (f->hoehe + (float)p[1]), 0.5f * f->hoehe,
+                       f->abstand, (float)(2.0 * PI / p[0])};
+    FitModellSpalten(&c, m, f->y, modell, jac, jac + m, jac + 2 * m, jac + 3 * m, jac + 4 * m, jac + 5 * m);
+}
+
+static double FitKosten(const Fit* f, const double* p, float* modell, float* jac) {
+    FitModell(f, p, modell, jac);
+    double summe = 0.0;
+    for (int i = 0; i < f->m; i++) {
+        double r = f->profil[i] - modell[i];
+        summe += r * r;
+    }
+    double q = (p[0] - f->lambda0) / f->lambda0;
+    return summe + FIT_PRIOR * f->m * q * q;
+}
+
+// Löst a x = b für symmetrisches positiv definites a (Cholesky), false bei Versagen.
+static bool FitLoesen(double a[FIT_PARAMETER][FIT_PARAMETER], double* b, double* x) {
+    const int n = FIT_PARAMETER;
+    double l[FIT_PARAMETER][FIT_PARAMETER] = {0};
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double s = a[i][j];
+            for (int k = 0; k < j; k++) s -= l[i][k] * l[j][k];
+            if (i == j) {
+                if (s <= 0.0) return false;
+                l[i][i] = sqrt(s);
+            } else {
+                l[i][j] = s / l[j][j];
+            }
+        }
+    }
+    double z[FIT_PARAMETER];
+    for (int i = 0; i < n; i++) {
+        double s = b[i];
+        for (int k = 0; k < i; k++) s -= l[i][k] * z[k];
+        z[i] = s / l[i][i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double s = z[i];
+        for (int k = i + 1; k < n; k++) s -= l[k][i] * x[k];
+        x[i] = s / l[i][i];
+    }
+    return true;
+}
+
+// Wertebereiche der Regler, w zwischen einem Pixel und gitterD.
+static void FitBegrenzen(double* p) {
+    p[0] = fmin(fmax(p[0], 10.0), 85.0);
+    p[1] = fmin(fmax(p[1], 0.0), 150.0);
+    p[2] = fmin(fmax(p[2], -90.0), 90.0);
+    p[3] = fmin(fmax(p[3], 1.0), fmax(p[1], 1.0));
+}
+
+static void FitLevenbergMarquardt(const Fit* f, FitLauf* lauf, float* modell, float* jac) {
+    double* p = lauf->p;
+    double kosten = FitKosten(f, p, modell, jac);
+    double mu = 1e-3;
+    const int m = f->m;
+    const double prior = sqrt(FIT_PRIOR * m) / f->lambda0;
+
+    int it;
+    for (it = 0; it < FIT_ITERATIONEN; it++) {
+        // Normalgleichungen an der aktuellen Stelle (modell, jac sind aktuell).
+        double n[FIT_PARAMETER][FIT_PARAMETER] = {0}, g[FIT_PARAMETER] = {0};
+        for (int a = 0; a < FIT_PARAMETER; a++) {
+            const float* ja = jac + a * m;
+            for (int i = 0; i < m; i++) g[a] += (double)ja[i] * (f->profil[i] - modell[i]);
+            for (int b = 0; b <= a; b++) {
+                const float* jb = jac + b * m;
+                double s = 0.0;
+                for (int i = 0; i < m; i++) s += (double)ja[i] * jb[i];
+                n[a][b] = n[b][a] = s;
+            }
+        }
+        n[0][0] += prior * prior;
+        g[0] += prior * (f->lambda0 - p[0]);
+
+        bool besser = false;
+        double neu[FIT_PARAMETER];
+        while (mu < 1e10) {
+            double a[FIT_PARAMETER][FIT_PARAMETER], delta[FIT_PARAMETER];
+            memcpy(a, n, sizeof(a));
+            for (int i = 0; i < FIT_PARAMETER; i++) a[i][i] += mu * (n[i][i] + 1e-12);
+            if (FitLoesen(a, g, delta)) {
+                for (int i = 0; i < FIT_PARAMETER; i++) neu[i] = p[i] + delta[i];
+                FitBegrenzen(neu);
+                double k = FitKosten(f, neu, modell, jac);
+                if (k < kosten) {
+                    besser = kosten - k > 1e-10 * kosten;
+                    memcpy(p, neu, sizeof(neu));
+                    kosten = k;
+                    mu = fmax(mu / 3.0, 1e-9);
+                    break;
+                }
+            }
+            mu *= 4.0;
+        }
+        if (!besser) break;
+    }
+
+    // modell, jac können von einem verworfenen Schritt stammen.
+    lauf->kosten = FitKosten(f, p, modell, jac);
+    lauf->iterationen = it;
+}
+
+static void FitStarts(void* ctx, int begin, int end) {
+    Fit* f = (Fit*)ctx;
+    float* modell = malloc(f->m * sizeof(float));
+    float* jac = malloc(FIT_PARAMETER * f->m * sizeof(float));
+
+    for (int s = begin; s < end; s++) FitLevenbergMarquardt(f, &f->laeufe[s], modell, jac);
+
+    free(modell);
+    free(jac);
+}
+
+static void RunFit(Fit* f) {
+    static const double startD[] = {15, 30, 45, 60, 80, 100, 125, 150};
+    static const double startPhi[] = {-15, -7.5, 0, 7.5, 15};
+    static const double startW[] = {4, 10, 20};
+    const int nd = sizeof(startD) / sizeof(startD[0]);
+    const int np = sizeof(startPhi) / sizeof(startPhi[0]);
+    const int nw = sizeof(startW) / sizeof(startW[0]);
+
+    double start = NowSeconds();
+    float lo = f->profil[0], hi = f->profil[0];
+    for (int i = 1; i < f->m; i++) {
+        lo = fminf(lo, f->profil[i]);
+        hi = fmaxf(hi, f->profil[i]);
+    }
+
+    f->starts = nd * np * nw;
+    f->laeufe = realloc(f->laeufe, f->starts * sizeof(FitLauf));
+    for (int s = 0; s < f->starts; s++) {
+        FitLauf* lauf = &f->laeufe[s];
+        lauf->p[0] = f->lambda0;
+        lauf->p[1] = startD[s % nd];
+        lauf->p[2] = startPhi[(s / nd) % np];
+        lauf->p[3] = startW[s / (nd * np)];
+        lauf->p[4] = hi - lo;
+        lauf->p[5] = lo;
+        FitBegrenzen(lauf->p);
+    }
+    ParallelFor(f->starts, 1, FitStarts, f);
+
+    f->bester = f->laeufe[0];
+    for (int s = 1; s < f->starts; s++) {
+        if (f->laeufe[s].kosten < f->bester.kosten) f->bester = f->laeufe[s];
+    }
+
+    float* jac = malloc(FIT_PARAMETER * f->m * sizeof(float));
+    f->modell = realloc(f->modell, f->m * sizeof(float));
+    FitModell(f, f->bester.p, f->modell, jac);
+    free(jac);
+
+    f->rechenzeit = NowSeconds() - start;
+    f->neu = true;
+}
+
+// Lädt das Bild, mittelt quer zur Streifenachse und passt an.
+static bool LadeFitBild(Fit* f, const char* datei, int width, int height, AppState* state) {
+    Image bild = LoadImage(datei);
+    if (bild.data == NULL) return false;
+    ImageColorGrayscale(&bild);
+    ImageFormat(&bild, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    const unsigned char* grau = bild.data;
+    int bw = bild.width, bh = bild.height;
+
+    float* zeilen = calloc(bh, sizeof(float));
+    float* spalten = calloc(bw, sizeof(float));
+    for (int y = 0; y < bh; y++) {
+        for (int x = 0; x < bw; x++) {
+            float v = grau[(size_t)y * bw + x] / 255.0f;
+            zeilen[y] += v / bw;
+            spalten[x] += v / bh;
+        }
+    }
+    UnloadImage(bild);
+
+    // Die Richtung mit der größeren Streuung des Mittels trägt die Streifen.
+    double varZ = 0.0, varS = 0.0, mittel = 0.0;
+    for (int y = 0; y < bh; y++) mittel += zeilen[y] / bh;
+    for (int y = 0; y < bh; y++) varZ += (zeilen[y] - mittel) * (zeilen[y] - mittel) / bh;
+    for (int x = 0; x < bw; x++) varS += (spalten[x] - mittel) * (spalten[x] - mittel) / bw;
+
+    free(f->profil);
+    free(f->y);
+    if (varZ >= varS) {
+        f->profil = zeilen;
+        f->m = bh;
+        free(spalten);
+    } else {
+        f->profil = spalten;
+        f->m = bw;
+        free(zeilen);
+    }
+    f->pixel = bw * bh;
+
+    Spalt s = SpaltGeometrie(width, height, state);
+    f->hoehe = (float)height;
+    f->abstand = (float)(width - s.xSpalt);
+    f->lambda0 = state->lambda;
+    f->y = malloc(f->m * sizeof(float));
+    for (int i = 0; i < f->m; i++) f->y[i] = (i + 0.5f) * height / f->m;
+
+    RunFit(f);
+    f->geladen = true;
+    return true;
+}
+
+// Gibt true zurück, wenn ein neues Ergebnis in die Regler übernommen werden soll.
+bool DrawFit(int width, int height, AppState* state, AppState* ergebnis) {
+    Fit* f = &fit;
+
+    if (IsFileDropped()) {
+        FilePathList dateien = LoadDroppedFiles();
+        if (dateien.count > 0) LadeFitBild(f, dateien.paths[0], width, height, state);
+        UnloadDroppedFiles(dateien);
+    }
+
+    if (!f->geladen) {
+        overlay_text("Fit: Graustufenbild eines Schirms auf das Fenster ziehen");
+        return false;
+    }
+
+    // Gemessenes Profil (grau) und Modell (rot) am rechten Rand.
+    float maxI = 1e-6f;
+    for (int i = 0; i < f->m; i++) maxI = fmaxf(maxI, fmaxf(f->profil[i], f->modell[i]));
+    Vector2 vorher[2] = {0};
+    for (int y = 0; y < height; y++) {
+        int i = (int)((y + 0.5f) * f->m / height);
+        Vector2 gemessen = {width - FIT_PLOT + f->profil[i] / maxI * (FIT_PLOT - 10), (float)y};
+        Vector2 modell = {width - FIT_PLOT + f->modell[i] / maxI * (FIT_PLOT - 10), (float)y};
+        if (y > 0) {
+            DrawLineV(vorher[0], gemessen, GRAY);
+            DrawLineV(vorher[1], modell, RED);
+        }
+        vorher[0] = gemessen;
+        vorher[1] = modell;
+    }
+
+    const double* p = f->bester.p;
+    overlay_text(TextFormat("Fit: lambda %.2f, D %.2f, Winkel %.2f, Spaltbreite %.2f", p[0], p[1], p[2] + 90.0, p[3]));
+    overlay_text(TextFormat("%d Pixel, %d Starts, %d Iterationen, Rest %.4f, %.0f ms", f->pixel, f->starts,
+                            f->bester.iterationen, sqrt(f->bester.kosten / f->m), f->rechenzeit * 1000.0));
+
+    if (!f->neu) return false;
+    f->neu = false;
+    ergebnis->lambda = (int)lround(p[0]);
+    ergebnis->gitterD = (int)lround(p[1]);
+    ergebnis->winkel = (int)lround(p[2] + 90.0);
+    return true;
+}
+
+void UnloadFit(void) {
+    free(fit.profil);
+    free(fit.y);
+    free(fit.laeufe);
+    free(fit.modell);
+    memset(&fit, 0, sizeof(fit));
+}
@@ -0,0 +1,179 @@
+// Hyperbel.c
+// Bauchlinien in geschlossener Form: r1 - r2 = c mit c = m lambda - d sin phi
+// ist ein Hyperbelast mit den Spalten als Brennpunkten. Mit e = d / 2,
+// a = |c| / 2 und b² = e² - a² gilt rechts der Wand
+//   x = xSpalt + b sinh t,  y = yMitte + sign(c) a cosh t,  t >= 0.
+// Abgetastet wird nach der Krümmung kappa(t) = a b / v(t)³ mit der
+// Bahngeschwindigkeit v(t) = sqrt(a² sinh² t + b² cosh² t): eine Sehne der
+// Länge l weicht um etwa kappa l² / 8 vom Bogen ab, l wird so gewählt, dass
+// das HYPERBEL_FEHLER Pixel bleiben.
+//
+// HyperbelPruefen (./main --pruefen) baut die Äste für ein Raster aus lambda,
+// gitterD und winkel und prüft jeden Punkt gegen r1 - r2 = c.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rlgl.h"
+
+#define HYPERBEL_FEHLER 0.25        // erlaubte Sehnenabweichung in Pixel
+#define HYPERBEL_MAX_SEHNE 64.0     // längste Sehne, auch auf fast geraden Stücken
+#define HYPERBEL_MAX_PUNKTE 4096    // pro Ast
+#define HYPERBEL_TOLERANZ 1e-3      // Pixel, die Punkte sind float
+
+typedef struct {
+    Vector2* punkte;
+    int anzahl, kapazitaet;
+    int* start;                     // linien + 1 Einträge in punkte
+    double* differenz;              // c je Linie
+    int linien, startKapazitaet;
+
+    int width, height;
+    AppState gebaut;
+    double rechenzeit;
+} Hyperbel;
+
+static Hyperbel hyperbel = {0};
+
+static void HyperbelPunkt(Hyperbel* h, double x, double y) {
+    if (h->anzahl == h->kapazitaet) {
+        h->kapazitaet = h->kapazitaet ? 2 * h->kapazitaet : 1024;
+        h->punkte = realloc(h->punkte, h->kapazitaet * sizeof(Vector2));
+    }
+    h->punkte[h->anzahl++] = (Vector2){(float)x, (float)y};
+}
+
+static void HyperbelLinieBeginnen(Hyperbel* h, double c) {
+    if (h->linien + 2 > h->startKapazitaet) {
+        h->startKapazitaet = h->startKapazitaet ? 2 * h->startKapazitaet : 64;
+        h->start = realloc(h->start, h->startKapazitaet * sizeof(int));
+        h->differenz = realloc(h->differenz, h->startKapazitaet * sizeof(double));
+    }
+    h->start[h->linien] = h->anzahl;
+    h->differenz[h->linien] = c;
+}
+
+// Ein Ast r1 - r2 = c, abgeschnitten am Fensterrand.
+static void HyperbelAst(Hyperbel* h, const Quellen* q, double c, int width, int height) {
+    double e = 0.5 * (q->y2 - q->y1);
+    double a = 0.5 * fabs(c);
+    double b = sqrt(e * e - a * a);
+    double vorzeichen = c < 0.0 ? -1.0 : 1.0;
+    double yMitte = 0.5 * (q->y1 + q->y2);
+
+    double tMax = asinh((width - q->x) / b);
+    if (a > 0.0) {
+        double rand = c < 0.0 ? yMitte : height - yMitte;
+        if (rand <= a) return;
+        tMax = fmin(tMax, acosh(rand / a));
+    }
+
+    HyperbelLinieBeginnen(h, c);
+    double t = 0.0;
+    for (int i = 0; i < HYPERBEL_MAX_PUNKTE; i++) {
+        double sh = sinh(t), ch = cosh(t);
+        double x = q->x + b * sh;
+        double y = yMitte + vorzeichen * a * ch;
+
+        HyperbelPunkt(h, x, y);
+        if (t >= tMax) break;
+
+        double v = sqrt(a * a * sh * sh + b * b * ch * ch);
+        double kappa = a * b / (v * v * v);
+        double sehne = kappa > 0.0 ? sqrt(8.0 * HYPERBEL_FEHLER / kappa) : HYPERBEL_MAX_SEHNE;
+        t = fmin(t + fmin(sehne, HYPERBEL_MAX_SEHNE) / v, tMax);
+    }
+    h->linien++;
+    h->start[h->linien] = h->anzahl;
+}
+
+static void BuildHyperbel(Hyperbel* h, int width, int height, AppState* state) {
+    Quellen q = QuellenGeometrie(width, height, state);
+    double d = q.y2 - q.y1;
+    double offset = (double)(q.s2 - q.s1);      // d sin phi
+    h->anzahl = 0;
+    h->linien = 0;
+    if (d <= 0.0) return;
+
+    // Alle Ordnungen m mit |m lambda - d sin phi| < d.
+    int mVon = (int)ceil((offset - d) / state->lambda);
+    int mBis = (int)floor((offset + d) / state->lambda);
+    for (int m = mVon; m <= mBis; m++) {
+        double c = m * state->lambda - offset;
+        if (fabs(c) >= d) continue;
+        HyperbelAst(h, &q, c, width, height);
+    }
+}
+
+void DrawHyperbel(int width, int height, AppState* state) {
+    Hyperbel* h = &hyperbel;
+
+    if (h->width != width || h->height != height || h->gebaut.lambda != state->lambda ||
+        h->gebaut.gitterD != state->gitterD || h->gebaut.winkel != state->winkel) {
+        double start = NowSeconds();
+        BuildHyperbel(h, width, height, state);
+        h->rechenzeit = NowSeconds() - start;
+        h->width = width;
+        h->height = height;
+        h->gebaut = *state;
+    }
+
+    rlBegin(RL_LINES);
+    rlColor4ub(190, 33, 55, 255);
+    for (int l = 0; l < h->linien; l++) {
+        for (int i = h->start[l]; i + 1 < h->start[l + 1]; i++) {
+            rlVertex2f(h->punkte[i].x, h->punkte[i].y);
+            rlVertex2f(h->punkte[i + 1].x, h->punkte[i + 1].y);
+        }
+    }
+    rlEnd();
+
+    overlay_text(TextFormat("Hyperbeln: %d Ordnungen, %d Punkte, %.3f ms", h->linien, h->anzahl,
+                            h->rechenzeit * 1000.0));
+}
+
+// Jeder Punkt muss r1 - r2 = c seiner Linie erfüllen und im Fenster rechts
+// der Wand liegen. Gibt die Zahl der Fehler zurück.
+static long HyperbelPruefen(int width, int height) {
+    Hyperbel h = {0};
+    long fehler = 0, punkte = 0, zustaende = 0;
+    double start = NowSeconds();
+    for (int lambda = 10; lambda <= 85; lambda++) {
+        for (int gitterD = 0; gitterD <= 150; gitterD += 3) {
+            for (int winkel = 0; winkel <= 180; winkel += 3) {
+                AppState state = {.lambda = lambda, .gitterD = gitterD, .winkel = winkel};
+                Quellen q = QuellenGeometrie(width, height, &state);
+                BuildHyperbel(&h, width, height, &state);
+                for (int l = 0; l < h.linien; l++) {
+                    for (int i = h.start[l]; i < h.start[l + 1]; i++) {
+                        double x = h.punkte[i].x, y = h.punkte[i].y;
+                        double r1 = hypot(x - q.x, y - q.y1), r2 = hypot(x - q.x, y - q.y2);
+                        bool gut = fabs(r1 - r2 - h.differenz[l]) <= HYPERBEL_TOLERANZ &&
+                                   x >= q.x - HYPERBEL_TOLERANZ && x <= width + HYPERBEL_TOLERANZ &&
+                                   y >= -HYPERBEL_TOLERANZ && y <= height + HYPERBEL_TOLERANZ;
+                        if (!gut && fehler++ < 10) {
+                            fprintf(stderr, "Hyperbel: lambda %d, gitterD %d, winkel %d, c %.3f: (%.3f, %.3f) "
+                                    "r1 - r2 = %.6f\n", lambda, gitterD, winkel, h.differenz[l], x, y, r1 - r2);
+                        }
+                    }
+                }
+                punkte += h.anzahl;
+                zustaende++;
+            }
+        }
+    }
+    printf("Hyperbeln %dx%d: %ld Zustände, %ld Punkte, %ld Fehler, %.1f s\n", width, height, zustaende, punkte,
+           fehler, NowSeconds() - start);
+    free(h.punkte);
+    free(h.start);
+    free(h.differenz);
+    return fehler;
+}
+
+void UnloadHyperbel(void) {
+    free(hyperbel.punkte);
+    free(hyperbel.start);
+    free(hyperbel.differenz);
+    memset(&hyperbel, 0, sizeof(hyperbel));
+}
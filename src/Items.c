@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <assert.h>
+#include <math.h>
 
 #include "raylib.h"
 #include "raymath.h"
@@ -17,6 +18,16 @@ static float lerpf(float min, float max, float value) {
     return min + value * (max - min);
 }
 
+#define SLIDER_IDS 8
+
+// Smoothed change of each slider's value per frame while it is dragged,
+// decaying to zero once released. Used to compute ahead of the drag.
+static float slider_velocities[SLIDER_IDS];
+
+static float slider_velocity(int id) {
+    return (id >= 0 && id < SLIDER_IDS) ? slider_velocities[id] : 0.0f;
+}
+
 static void slider(int id, Rectangle bounds, float *value, float min, float max, const char *label, bool show, float change_value) {
     bounds.x += MARGIN;
     //bounds.y += MARGIN;
@@ -31,6 +42,7 @@ static void slider(int id, Rectangle bounds, float *value, float min, float max,
     );
 
     assert(min <= max);
+    float previous_value = *value;
     float grip_value = ilerpf(min, max, *value) * bounds.width;
 
     float grip_pos_x = bounds.x + grip_value - SLIDER_GRIP_SIZE;
@@ -83,4 +95,34 @@ static void slider(int id, Rectangle bounds, float *value, float min, float max,
     } else if (active_id == id) {
         active_id = -1;
     }
+
+    if (id >= 0 && id < SLIDER_IDS) {
+        float change = (active_id == id) ? *value - previous_value : 0.0f;
+        slider_velocities[id] += 0.3f * (change - slider_velocities[id]);
+        if (fabsf(slider_velocities[id]) < 0.01f) slider_velocities[id] = 0.0f;
+    }
+}
+
+
+#define OVERLAY_LINES 16
+#define OVERLAY_LINE_SIZE 128
+
+static char overlay_lines[OVERLAY_LINES][OVERLAY_LINE_SIZE];
+static int overlay_count = 0;
+
+static void overlay_begin(void) {
+    overlay_count = 0;
+}
+
+// Lines are collected during the frame and drawn last, on top of everything.
+static void overlay_text(const char *text) {
+    if (overlay_count >= OVERLAY_LINES) return;
+    snprintf(overlay_lines[overlay_count], OVERLAY_LINE_SIZE, "%s", text);
+    overlay_count++;
+}
+
+static void overlay_end(int x, int y) {
+    for (int i = 0; i < overlay_count; i++) {
+        DrawText(overlay_lines[i], x, y + i * 22, 20, DARKGRAY);
+    }
 }
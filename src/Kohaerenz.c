@@ -0,0 +1,99 @@
+// Kohaerenz.c
+// Ausgedehnte Quelle: statt einer ebenen Welle unter winkel fallen Wellen aus
+// einem Winkelbereich der Breite quellBreite ein. Jeder Einfallswinkel phi_j
+// verschiebt nur die Phase zwischen den Spalten um k d sin phi_j (wie s0 in
+// DrawKugelwelle). Die Summe über alle Winkel faltet sich deshalb zu einem
+// komplexen Kohärenzgrad Gamma = sum_j w_j exp(i k d sin phi_j) zusammen:
+//   I = 1 + |Gamma| cos(k (r1 - r2) + arg Gamma),
+// |Gamma| ist die Streifensichtbarkeit. Pro Pixel bleibt ein Kosinus auf den
+// gecachten Abständen, unabhängig von der Zahl der Winkel. Das Bild wird mit
+// dynamischer Auflösung gefüllt (FeldStufen); die Zeit im Overlay gilt nur
+// dem Kohärenzgrad, die Pixel je Frame zeigt FeldStufen selbst.
+#include <math.h>
+#include <string.h>
+
+#define KOHAERENZ_WINKEL 256        // Stützstellen über die Quellbreite
+
+typedef struct {
+    float k;
+    float sichtbarkeit;             // |Gamma|
+    float phase;                    // arg Gamma
+
+    FeldGeometrie* geometrie;
+    FeldBild bild;
+    FeldStufen stufen;
+
+    int width, height;
+    float quellBreite;
+    AppState gebaut;
+    double rechenzeit;
+} Kohaerenz;
+
+static Kohaerenz kohaerenz = {0};
+
+static void BuildKohaerenzgrad(Kohaerenz* c, AppState* state, float quellBreite) {
+    double k = 2.0 * PI / state->lambda;
+    double re = 0.0, im = 0.0;
+
+    // Gleichverteilte Intensität über [winkel - b/2, winkel + b/2].
+    for (int j = 0; j < KOHAERENZ_WINKEL; j++) {
+        double t = (j + 0.5) / KOHAERENZ_WINKEL - 0.5;
+        double phi = (state->winkel - 90 + t * quellBreite) * PI / 180.0;
+        double psi = k * state->gitterD * sin(phi);
+        re += cos(psi);
+        im += sin(psi);
+    }
+    re /= KOHAERENZ_WINKEL;
+    im /= KOHAERENZ_WINKEL;
+
+    c->k = (float)k;
+    c->sichtbarkeit = (float)sqrt(re * re + im * im);
+    c->phase = (float)atan2(im, re);
+}
+
+static void KohaerenzKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Kohaerenz* c = (Kohaerenz*)ctx;
+    const FeldGeometrie* g = c->geometrie;
+    const float* r1 = g->r1 + (size_t)y * g->breite + x0;
+    const float* r2 = g->r2 + (size_t)y * g->breite + x0;
+    float intensitaet[FELD_TILE];
+
+    for (int i = 0; i < x1 - x0; i++) {
+        intensitaet[i] = 0.5f + 0.5f * c->sichtbarkeit * FastCos(c->k * (r1[i] - r2[i]) + c->phase);
+    }
+    for (int i = 0; i < x1 - x0; i++) {
+        unsigned char v = LinearToSrgb(intensitaet[i]);
+        out[i] = (Color){v, v, v, 255};
+    }
+}
+
+void DrawKohaerenz(int width, int height, AppState* state, float quellBreite) {
+    Kohaerenz* c = &kohaerenz;
+
+    if (c->width != width || c->height != height || c->quellBreite != quellBreite ||
+        c->gebaut.lambda != state->lambda || c->gebaut.gitterD != state->gitterD ||
+        c->gebaut.winkel != state->winkel) {
+        double start = NowSeconds();
+
+        c->geometrie = GetFeldGeometrie(width, height, state);
+        PrepareFeldBild(&c->bild, c->geometrie->x0, c->geometrie->breite, c->geometrie->hoehe);
+        BuildKohaerenzgrad(c, state, quellBreite);
+        FeldStufenStarten(&c->stufen, &c->bild, KohaerenzKernel, c);
+
+        c->rechenzeit = NowSeconds() - start;
+        c->width = width;
+        c->height = height;
+        c->quellBreite = quellBreite;
+        c->gebaut = *state;
+    }
+
+    DrawFeldStufen(&c->stufen, active_id >= 0);
+    overlay_text(TextFormat("Quellbreite %.1f Grad: Sichtbarkeit V = %.3f, %.1f ms",
+                            quellBreite, c->sichtbarkeit, c->rechenzeit * 1000.0));
+}
+
+void UnloadKohaerenz(void) {
+    FreeFeldStufen(&kohaerenz.stufen);
+    FreeFeldBild(&kohaerenz.bild);
+    memset(&kohaerenz, 0, sizeof(kohaerenz));
+}
@@ -0,0 +1,440 @@
+// Kontur.c
+// Knoten- und Bauchlinien als Höhenlinien des Gangunterschieds
+// f = r1 - r2 aus FeldGeometrie. Die Wellen sind gleichphasig, wo
+// f + d sin phi ein Vielfaches von lambda ist, gegenphasig bei halben
+// Vielfachen; die Niveaus liegen also im Abstand lambda / 2 bei
+//   L_j = j lambda / 2 - d sin phi.
+// Marching Squares läuft kachelweise parallel, jede Kachel verkettet ihre
+// Segmente selbst. Danach werden nur noch die Kettenenden über die
+// Kachelnähte verbunden: jeder Schnittpunkt trägt als Schlüssel Niveau und
+// Gitterkante, Nachbarkacheln rechnen für dieselbe Kante denselben Punkt.
+// Ändert sich nur das Niveau (lambda, winkel), bleiben f und die Wertebereiche
+// der Kacheln stehen, Kacheln ohne Niveau im Bereich werden übersprungen.
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rlgl.h"
+
+#define KONTUR_TILE 64
+#define KONTUR_KEIN UINT64_MAX      // Kettenende ohne Schlüssel (geschlossene Kette)
+#define KONTUR_KANTEN_BITS 40       // Schlüssel: Niveau << 40 | Kante
+
+typedef struct {
+    uint64_t kopf, fuss;            // Schlüssel der beiden Enden
+    int erster, anzahl;             // Punkte in KonturListe.punkte
+    int stufe;                      // Niveauindex j
+} KonturStueck;
+
+typedef struct {
+    KonturStueck* stuecke;
+    int anzahl, kapazitaet;
+    Vector2* punkte;
+    int punktAnzahl, punktKapazitaet;
+} KonturListe;
+
+typedef struct {
+    uint64_t schluessel;
+    int ref;                        // 2 * Stück + Ende (0 = kopf, 1 = fuss)
+} KonturEnde;
+
+typedef struct {
+    KonturEnde* enden;
+    int* partner;
+    unsigned char* besucht;
+    int kapazitaet;
+} KonturHilfe;
+
+typedef struct {
+    float min, max;                 // Wertebereich von f in der Kachel
+    KonturListe segmente;
+    KonturListe ketten;
+    KonturHilfe hilfe;
+} KonturKachel;
+
+typedef struct {
+    FeldGeometrie* geometrie;
+    KonturKachel* kacheln;
+    int kachelnX, kachelnY;
+
+    float abstand, basis;           // L_j = basis + j * abstand
+    int jBias;                      // j + jBias >= 0 für den Schlüssel
+
+    KonturListe sammel;             // alle Kachelketten hintereinander
+    KonturListe linien;             // verbundene Linien
+    KonturHilfe hilfe;
+
+    int width, height, gitterD;
+    AppState gebaut;
+    int neu, uebersprungen;         // Kacheln im letzten Lauf
+    double zeitKacheln, zeitNaht;
+} Kontur;
+
+static Kontur kontur = {0};
+
+static void KonturListeLeeren(KonturListe* l) {
+    l->anzahl = 0;
+    l->punktAnzahl = 0;
+}
+
+static void KonturPunkt(KonturListe* l, Vector2 p) {
+    if (l->punktAnzahl == l->punktKapazitaet) {
+        l->punktKapazitaet = l->punktKapazitaet ? 2 * l->punktKapazitaet : 256;
+        l->punkte = realloc(l->punkte, l->punktKapazitaet * sizeof(Vector2));
+    }
+    l->punkte[l->punktAnzahl++] = p;
+}
+
+static void KonturStueckAnhaengen(KonturListe* l, KonturStueck s) {
+    if (l->anzahl == l->kapazitaet) {
+        l->kapazitaet = l->kapazitaet ? 2 * l->kapazitaet : 64;
+        l->stuecke = realloc(l->stuecke, l->kapazitaet * sizeof(KonturStueck));
+    }
+    l->stuecke[l->anzahl++] = s;
+}
+
+static void FreeKonturListe(KonturListe* l) {
+    free(l->stuecke);
+    free(l->punkte);
+    memset(l, 0, sizeof(*l));
+}
+
+static void FreeKonturHilfe(KonturHilfe* h) {
+    free(h->enden);
+    free(h->partner);
+    free(h->besucht);
+    memset(h, 0, sizeof(*h));
+}
+
+static int KonturEndeVergleich(const void* a, const void* b) {
+    uint64_t ka = ((const KonturEnde*)a)->schluessel, kb = ((const KonturEnde*)b)->schluessel;
+    return (ka > kb) - (ka < kb);
+}
+
+// Hängt die Punkte von Stück s an, umgekehrt falls rueckwaerts; der erste
+// Punkt entfällt, wenn er schon als letzter Punkt der Kette dasteht.
+static void KonturStueckKopieren(const KonturListe* ein, const KonturStueck* s, bool rueckwaerts,
+                                 bool ohneErsten, KonturListe* aus) {
+    for (int i = ohneErsten ? 1 : 0; i < s->anzahl; i++) {
+        int k = rueckwaerts ? s->anzahl - 1 - i : i;
+        KonturPunkt(aus, ein->punkte[s->erster + k]);
+    }
+}
+
+// Verbindet die Stücke aus ein an gleichen Endschlüsseln zu möglichst langen
+// Ketten und schreibt sie nach aus. Jeder Schlüssel kommt höchstens zweimal vor.
+static void KonturVerketten(const KonturListe* ein, KonturListe* aus, KonturHilfe* h) {
+    int n = ein->anzahl;
+    KonturListeLeeren(aus);
+    if (n == 0) return;
+
+    if (h->kapazitaet < n) {
+        h->kapazitaet = n;
+        h->enden = realloc(h->enden, 2 * n * sizeof(KonturEnde));
+        h->partner = realloc(h->partner, 2 * n * sizeof(int));
+        h->besucht = realloc(h->besucht, n);
+    }
+
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        const KonturStueck* s = &ein->stuecke[i];
+        if (s->kopf != KONTUR_KEIN) h->enden[m++] = (KonturEnde){s->kopf, 2 * i};
+        if (s->fuss != KONTUR_KEIN) h->enden[m++] = (KonturEnde){s->fuss, 2 * i + 1};
+        h->partner[2 * i] = h->partner[2 * i + 1] = -1;
+        h->besucht[i] = 0;
+    }
+    qsort(h->enden, m, sizeof(KonturEnde), KonturEndeVergleich);
+    for (int i = 0; i + 1 < m; i++) {
+        if (h->enden[i].schluessel != h->enden[i + 1].schluessel) continue;
+        h->partner[h->enden[i].ref] = h->enden[i + 1].ref;
+        h->partner[h->enden[i + 1].ref] = h->enden[i].ref;
+        i++;
+    }
+
+    // Erst die offenen Ketten von einem freien Ende aus, dann die Ringe.
+    for (int runde = 0; runde < 2; runde++) {
+        for (int i = 0; i < n; i++) {
+            if (h->besucht[i]) continue;
+            int eingang;
+            if (h->partner[2 * i] < 0) eingang = 0;
+            else if (h->partner[2 * i + 1] < 0) eingang = 1;
+            else if (runde == 1) eingang = 0;
+            else continue;
+
+            KonturStueck kette = {KONTUR_KEIN, KONTUR_KEIN, aus->punktAnzahl, 0, ein->stuecke[i].stufe};
+            kette.kopf = eingang == 0 ? ein->stuecke[i].kopf : ein->stuecke[i].fuss;
+            int j = i, ausgang = 0;
+            for (;;) {
+                const KonturStueck* s = &ein->stuecke[j];
+                h->besucht[j] = 1;
+                KonturStueckKopieren(ein, s, eingang == 1, j != i, aus);
+                ausgang = 1 - eingang;
+                int weiter = h->partner[2 * j + ausgang];
+                if (weiter < 0 || h->besucht[weiter >> 1]) break;
+                j = weiter >> 1;
+                eingang = weiter & 1;
+            }
+            const KonturStueck* letztes = &ein->stuecke[j];
+            kette.fuss = ausgang == 1 ? letztes->fuss : letztes->kopf;
+            // Ein Ring endet wieder auf seinem Startpunkt und hat kein freies Ende.
+            if (runde == 1) kette.kopf = kette.fuss = KONTUR_KEIN;
+            kette.anzahl = aus->punktAnzahl - kette.erster;
+            KonturStueckAnhaengen(aus, kette);
+        }
+    }
+}
+
+// Schnittpunkt auf der Kante a -> b (a links bzw. oben), unabhängig davon,
+// aus welcher Zelle gefragt wird, damit Nachbarkacheln bitgleich rechnen.
+static Vector2 KonturKantenPunkt(const FeldGeometrie* g, int xa, int ya, int xb, int yb, float fa, float fb,
+                                 float niveau) {
+    float t = (niveau - fa) / (fb - fa);
+    return (Vector2){g->x0 + xa + 0.5f + t * (xb - xa), ya + 0.5f + t * (yb - ya)};
+}
+
+static inline float KonturWert(const FeldGeometrie* g, int x, int y) {
+    size_t i = (size_t)y * g->breite + x;
+    return g->r1[i] - g->r2[i];
+}
+
+static void KonturBereiche(void* ctx, int begin, int end) {
+    Kontur* c = (Kontur*)ctx;
+    const FeldGeometrie* g = c->geometrie;
+
+    for (int t = begin; t < end; t++) {
+        int cx = (t % c->kachelnX) * KONTUR_TILE, cy = (t / c->kachelnX) * KONTUR_TILE;
+        int xe = cx + KONTUR_TILE < g->breite - 1 ? cx + KONTUR_TILE : g->breite - 1;
+        int ye = cy + KONTUR_TILE < g->hoehe - 1 ? cy + KONTUR_TILE : g->hoehe - 1;
+        float lo = INFINITY, hi = -INFINITY;
+        for (int y = cy; y <= ye; y++) {
+            for (int x = cx; x <= xe; x++) {
+                float f = KonturWert(g, x, y);
+                lo = fminf(lo, f);
+                hi = fmaxf(hi, f);
+            }
+        }
+        c->kacheln[t].min = lo;
+        c->kacheln[t].max = hi;
+    }
+}
+
+// Kanten der Zelle: 0 oben, 1 rechts, 2 unten, 3 links.
+static void KonturKante(const Kontur* c, int x, int y, int kante, const float* f, float niveau, int stufe,
+                        uint64_t* schluessel, Vector2* p) {
+    const FeldGeometrie* g = c->geometrie;
+    uint64_t id;
+    switch (kante) {
+    case 0:
+        id = 2 * ((uint64_t)y * g->breite + x);
+        *p = KonturKantenPunkt(g, x, y, x + 1, y, f[0], f[1], niveau);
+        break;
+    case 1:
+        id = 2 * ((uint64_t)y * g->breite + x + 1) + 1;
+        *p = KonturKantenPunkt(g, x + 1, y, x + 1, y + 1, f[1], f[2], niveau);
+        break;
+    case 2:
+        id = 2 * ((uint64_t)(y + 1) * g->breite + x);
+        *p = KonturKantenPunkt(g, x, y + 1, x + 1, y + 1, f[3], f[2], niveau);
+        break;
+    default:
+        id = 2 * ((uint64_t)y * g->breite + x) + 1;
+        *p = KonturKantenPunkt(g, x, y, x, y + 1, f[0], f[3], niveau);
+        break;
+    }
+    *schluessel = ((uint64_t)(stufe + c->jBias) << KONTUR_KANTEN_BITS) | id;
+}
+
+static void KonturSegment(const Kontur* c, KonturListe* l, int x, int y, const float* f, float niveau, int stufe,
+                          int ka, int kb) {
+    KonturStueck s = {0, 0, l->punktAnzahl, 2, stufe};
+    Vector2 pa, pb;
+    KonturKante(c, x, y, ka, f, niveau, stufe, &s.kopf, &pa);
+    KonturKante(c, x, y, kb, f, niveau, stufe, &s.fuss, &pb);
+    KonturPunkt(l, pa);
+    KonturPunkt(l, pb);
+    KonturStueckAnhaengen(l, s);
+}
+
+static void KonturKachelnRechnen(void* ctx, int begin, int end) {
+    Kontur* c = (Kontur*)ctx;
+    const FeldGeometrie* g = c->geometrie;
+
+    for (int t = begin; t < end; t++) {
+        KonturKachel* k = &c->kacheln[t];
+        KonturListeLeeren(&k->segmente);
+
+        int jVon = (int)ceilf((k->min - c->basis) / c->abstand);
+        int jBis = (int)floorf((k->max - c->basis) / c->abstand);
+        if (jVon > jBis) {
+            KonturListeLeeren(&k->ketten);
+            continue;
+        }
+
+        int cx = (t % c->kachelnX) * KONTUR_TILE, cy = (t / c->kachelnX) * KONTUR_TILE;
+        int xe = cx + KONTUR_TILE < g->breite - 1 ? cx + KONTUR_TILE : g->breite - 1;
+        int ye = cy + KONTUR_TILE < g->hoehe - 1 ? cy + KONTUR_TILE : g->hoehe - 1;
+
+        // Pro Knoten das Band floor((f - basis) / abstand); nur Zellen mit
+        // verschiedenen Bändern an den Ecken werden geschnitten.
+        float zeileF[2][KONTUR_TILE + 1];
+        int zeileB[2][KONTUR_TILE + 1];
+        float inv = 1.0f / c->abstand;
+        for (int x = cx; x <= xe; x++) {
+            zeileF[0][x - cx] = KonturWert(g, x, cy);
+            zeileB[0][x - cx] = (int)floorf((zeileF[0][x - cx] - c->basis) * inv);
+        }
+
+        for (int y = cy; y < ye; y++) {
+            float* fo = zeileF[(y - cy) & 1];
+            float* fu = zeileF[(y - cy + 1) & 1];
+            int* bo = zeileB[(y - cy) & 1];
+            int* bu = zeileB[(y - cy + 1) & 1];
+            for (int x = cx; x <= xe; x++) {
+                fu[x - cx] = KonturWert(g, x, y + 1);
+                bu[x - cx] = (int)floorf((fu[x - cx] - c->basis) * inv);
+            }
+
+            for (int x = cx; x < xe; x++) {
+                int i = x - cx;
+                int bMin = bo[i] < bo[i + 1] ? bo[i] : bo[i + 1];
+                int bMax = bo[i] > bo[i + 1] ? bo[i] : bo[i + 1];
+                bMin = bu[i] < bMin ? bu[i] : bMin;
+                bMax = bu[i] > bMax ? bu[i] : bMax;
+                bMin = bu[i + 1] < bMin ? bu[i + 1] : bMin;
+                bMax = bu[i + 1] > bMax ? bu[i + 1] : bMax;
+                if (bMin == bMax) continue;
+
+                // Ecken im Uhrzeigersinn ab oben links.
+                float f[4] = {fo[i], fo[i + 1], fu[i + 1], fu[i]};
+                int j0 = bMin + 1, j1 = bMax;
+
+                for (int j = j0; j <= j1; j++) {
+                    float niveau = c->basis + j * c->abstand;
+                    int fall = (f[0] >= niveau) | (f[1] >= niveau) << 1 | (f[2] >= niveau) << 2 |
+                               (f[3] >= niveau) << 3;
+                    if (fall == 0 || fall == 15) continue;
+
+                    if (fall == 5 || fall == 10) {
+                        // Sattel: der Mittelwert entscheidet, welche Ecken verbunden sind.
+                        bool mitte = 0.25f * (f[0] + f[1] + f[2] + f[3]) >= niveau;
+                        if ((fall == 5) == mitte) {
+                            KonturSegment(c, &k->segmente, x, y, f, niveau, j, 0, 1);
+                            KonturSegment(c, &k->segmente, x, y, f, niveau, j, 2, 3);
+                        } else {
+                            KonturSegment(c, &k->segmente, x, y, f, niveau, j, 0, 3);
+                            KonturSegment(c, &k->segmente, x, y, f, niveau, j, 1, 2);
+                        }
+                        continue;
+                    }
+
+                    int kanten[2], n = 0;
+                    for (int e = 0; e < 4; e++) {
+                        if (((fall >> e) & 1) != ((fall >> ((e + 1) & 3)) & 1)) kanten[n++] = e;
+                    }
+                    KonturSegment(c, &k->segmente, x, y, f, niveau, j, kanten[0], kanten[1]);
+                }
+            }
+        }
+
+        KonturVerketten(&k->segmente, &k->ketten, &k->hilfe);
+    }
+}
+
+static void FreeKonturKacheln(Kontur* c) {
+    for (int t = 0; t < c->kachelnX * c->kachelnY; t++) {
+        FreeKonturListe(&c->kacheln[t].segmente);
+        FreeKonturListe(&c->kacheln[t].ketten);
+        FreeKonturHilfe(&c->kacheln[t].hilfe);
+    }
+    free(c->kacheln);
+    c->kacheln = NULL;
+    c->kachelnX = c->kachelnY = 0;
+}
+
+static void BuildKontur(Kontur* c, int width, int height, AppState* state) {
+    bool feldNeu = c->width != width || c->height != height || c->gitterD != state->gitterD;
+    c->geometrie = GetFeldGeometrie(width, height, state);
+    const FeldGeometrie* g = c->geometrie;
+
+    double start = NowSeconds();
+    if (feldNeu) {
+        FreeKonturKacheln(c);
+        c->kachelnX = (g->breite - 1 + KONTUR_TILE - 1) / KONTUR_TILE;
+        c->kachelnY = (g->hoehe - 1 + KONTUR_TILE - 1) / KONTUR_TILE;
+        c->kacheln = calloc((size_t)c->kachelnX * c->kachelnY, sizeof(KonturKachel));
+        ParallelFor(c->kachelnX * c->kachelnY, 1, KonturBereiche, c);
+    }
+
+    double phi = (state->winkel - 90) * PI / 180.0;
+    c->abstand = 0.5f * state->lambda;
+    c->basis = (float)(-state->gitterD * sin(phi));
+    c->jBias = (int)ceilf((float)(g->breite + g->hoehe) / c->abstand) + 1;
+
+    ParallelFor(c->kachelnX * c->kachelnY, 1, KonturKachelnRechnen, c);
+
+    c->neu = c->uebersprungen = 0;
+    for (int t = 0; t < c->kachelnX * c->kachelnY; t++) {
+        if (c->kacheln[t].segmente.anzahl > 0) c->neu++;
+        else c->uebersprungen++;
+    }
+    double mitte = NowSeconds();
+
+    // Naht: alle Kachelketten in eine Liste, dann dieselbe Verkettung global.
+    KonturListeLeeren(&c->sammel);
+    for (int t = 0; t < c->kachelnX * c->kachelnY; t++) {
+        const KonturListe* k = &c->kacheln[t].ketten;
+        for (int i = 0; i < k->anzahl; i++) {
+            KonturStueck s = k->stuecke[i];
+            int erster = c->sammel.punktAnzahl;
+            for (int p = 0; p < s.anzahl; p++) KonturPunkt(&c->sammel, k->punkte[s.erster + p]);
+            s.erster = erster;
+            KonturStueckAnhaengen(&c->sammel, s);
+        }
+    }
+    KonturVerketten(&c->sammel, &c->linien, &c->hilfe);
+
+    c->zeitKacheln = mitte - start;
+    c->zeitNaht = NowSeconds() - mitte;
+    c->width = width;
+    c->height = height;
+    c->gitterD = state->gitterD;
+    c->gebaut = *state;
+}
+
+void DrawKontur(int width, int height, AppState* state) {
+    Kontur* c = &kontur;
+
+    if (c->width != width || c->height != height || c->gebaut.lambda != state->lambda ||
+        c->gebaut.gitterD != state->gitterD || c->gebaut.winkel != state->winkel) {
+        BuildKontur(c, width, height, state);
+    }
+
+    // Gerade j: Bauchlinien (Maxima), ungerade j: Knotenlinien.
+    rlBegin(RL_LINES);
+    for (int i = 0; i < c->linien.anzahl; i++) {
+        const KonturStueck* s = &c->linien.stuecke[i];
+        if (s->stufe & 1) rlColor4ub(0, 82, 172, 255);
+        else rlColor4ub(190, 33, 55, 255);
+        const Vector2* p = c->linien.punkte + s->erster;
+        for (int k = 0; k + 1 < s->anzahl; k++) {
+            rlVertex2f(p[k].x, p[k].y);
+            rlVertex2f(p[k + 1].x, p[k + 1].y);
+        }
+    }
+    rlEnd();
+
+    overlay_text(TextFormat("Konturen: %d Linien, %d Punkte, Kacheln %d aktiv / %d leer",
+                            c->linien.anzahl, c->linien.punktAnzahl, c->neu, c->uebersprungen));
+    overlay_text(TextFormat("Marching Squares %.2f ms, Naht %.2f ms", c->zeitKacheln * 1000.0,
+                            c->zeitNaht * 1000.0));
+}
+
+void UnloadKontur(void) {
+    Kontur* c = &kontur;
+    FreeKonturKacheln(c);
+    FreeKonturListe(&c->sammel);
+    FreeKonturListe(&c->linien);
+    FreeKonturHilfe(&c->hilfe);
+    memset(c, 0, sizeof(*c));
+}
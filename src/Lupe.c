@@ -0,0 +1,390 @@
+// Lupe.c
+// Vergrößerte Ansicht des Zwei-Spalt-Felds rechts der Wand, um die Streifen
+// dicht an den Spalten aufzulösen. Mausrad (oder +/-) zoomt in Zweierstufen
+// um den Mauszeiger, Ziehen verschiebt, C stellt die Ansicht zurück.
+//
+// Das Bild besteht aus Kacheln von LUPE_KACHEL x LUPE_KACHEL Bildpixeln, die
+// auf einem festen Raster der Zoomstufe liegen: Kachel (tx, ty) der Stufe z
+// überdeckt die Fensterpixel [tx, tx + 1) * LUPE_KACHEL / 2^z. Verschieben
+// deckt damit nur Randkacheln neu auf, alle anderen kommen aus dem Cache.
+// Schlüssel ist (Stufe, tx, ty) mit den Größen aus AppState und Fenster, die
+// das Feld bestimmen; Rückwege zu einem früheren Zustand kosten so nichts.
+//
+// Fehlende sichtbare Kacheln werden von der Bildmitte nach außen sortiert und
+// als Scheibenarbeit (Zeitscheibe.c) im Pool gerechnet, was nicht ins Budget
+// passt, folgt im nächsten Frame. Bis dahin steht dort, falls vorhanden, die
+// vergrößerte Kachel der nächstgröberen Stufe. Der Cache ist nach Bytes
+// begrenzt (Werte plus Textur, DOPPELSPALT_LUPE_MB, Vorgabe LUPE_CACHE_MB)
+// und verdrängt die am längsten nicht gezeigte Kachel.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LUPE_KACHEL 64
+#define LUPE_ZOOM_MAX 10            // 2^10-fach, darüber reicht float für die Koordinaten nicht
+#define LUPE_CACHE_MB 64
+#define LUPE_EIMER 4096
+#define LUPE_PIXEL (LUPE_KACHEL * LUPE_KACHEL)
+#define LUPE_KACHEL_BYTES (LUPE_PIXEL * (sizeof(float) + sizeof(Color)))
+
+typedef struct {
+    int zoom, tx, ty;
+    int lambda, gitterD, winkel;
+    int width, height;
+} LupeSchluessel;
+
+typedef struct {
+    LupeSchluessel schluessel;
+    float* werte;                   // Intensität je Pixel, relativ zu (a1 + a2)^2
+    Texture2D textur;
+    long benutzt;                   // Frame der letzten Anzeige
+    int naechste;                   // Kette im Eimer, -1: Ende
+} LupeKachel;
+
+typedef struct {
+    LupeSchluessel schluessel;
+    float abstand;                  // zur Bildmitte, zum Sortieren
+    int kachel;                     // Index in kacheln, sobald belegt
+} LupeFehlend;
+
+typedef struct {
+    LupeKachel* kacheln;
+    int kapazitaet, belegt;
+    int eimer[LUPE_EIMER];
+
+    LupeFehlend* fehlend;
+    int fehlendAnzahl, fehlendKapazitaet;
+    Color* farben;                  // Pixel der Kacheln eines Stücks
+    int farbenKacheln;
+
+    Scheibenarbeit arbeit;
+    FaQuellen quellen;
+    float xWand;                    // links davon kein Feld
+    long frame;
+
+    int zoom;
+    Vector2 mitte;                  // Fensterpunkt in der Bildmitte
+    bool ziehen;
+    int width, height;
+
+    long treffer, fehlschlaege, verdraengt;  // Treffer: wieder aufgedeckt, Fehlschläge: gerechnet
+    int gerechnet;                  // in diesem Frame
+    double rechenzeit;
+} Lupe;
+
+static Lupe lupe = {0};
+
+static unsigned int LupeHash(const LupeSchluessel* s) {
+    const int* w = (const int*)s;
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < sizeof(*s) / sizeof(int); i++) h = (h ^ (unsigned int)w[i]) * 16777619u;
+    return h % LUPE_EIMER;
+}
+
+static bool LupeGleich(const LupeSchluessel* a, const LupeSchluessel* b) {
+    return memcmp(a, b, sizeof(*a)) == 0;
+}
+
+static int LupeSuchen(Lupe* l, const LupeSchluessel* s) {
+    for (int i = l->eimer[LupeHash(s)]; i >= 0; i = l->kacheln[i].naechste) {
+        if (LupeGleich(&l->kacheln[i].schluessel, s)) return i;
+    }
+    return -1;
+}
+
+static void LupeAushaengen(Lupe* l, int k) {
+    int* p = &l->eimer[LupeHash(&l->kacheln[k].schluessel)];
+    while (*p != k) p = &l->kacheln[*p].naechste;
+    *p = l->kacheln[k].naechste;
+}
+
+static void LupeEinhaengen(Lupe* l, int k) {
+    int* p = &l->eimer[LupeHash(&l->kacheln[k].schluessel)];
+    l->kacheln[k].naechste = *p;
+    *p = k;
+}
+
+static void LupeAnlegen(Lupe* l) {
+    const char* mb = getenv("DOPPELSPALT_LUPE_MB");
+    double budget = (mb ? atof(mb) : LUPE_CACHE_MB) * 1024.0 * 1024.0;
+    if (budget <= 0.0) budget = LUPE_CACHE_MB * 1024.0 * 1024.0;
+    l->kapazitaet = (int)(budget / LUPE_KACHEL_BYTES);
+    if (l->kapazitaet < 1) l->kapazitaet = 1;
+    l->kacheln = calloc((size_t)l->kapazitaet, sizeof(LupeKachel));
+    for (int i = 0; i < LUPE_EIMER; i++) l->eimer[i] = -1;
+}
+
+// Freier Platz oder die am längsten nicht gezeigte Kachel; -1, wenn alle in
+// diesem Frame zu sehen sind.
+static int LupePlatz(Lupe* l) {
+    if (l->belegt < l->kapazitaet) return l->belegt++;
+    int alt = -1;
+    for (int i = 0; i < l->kapazitaet; i++) {
+        if (l->kacheln[i].benutzt < l->frame && (alt < 0 || l->kacheln[i].benutzt < l->kacheln[alt].benutzt)) alt = i;
+    }
+    if (alt >= 0) {
+        LupeAushaengen(l, alt);
+        l->verdraengt++;
+    }
+    return alt;
+}
+
+static void LupeKachelRechnen(const Lupe* l, int k, Color* out) {
+    const LupeSchluessel* s = &l->kacheln[k].schluessel;
+    float* werte = l->kacheln[k].werte;
+    float skala = 1.0f / (float)(1 << s->zoom);
+    float x[LUPE_PIXEL], y[LUPE_PIXEL];
+    for (int j = 0; j < LUPE_KACHEL; j++) {
+        for (int i = 0; i < LUPE_KACHEL; i++) {
+            x[j * LUPE_KACHEL + i] = (s->tx * LUPE_KACHEL + i + 0.5f) * skala;
+            y[j * LUPE_KACHEL + i] = (s->ty * LUPE_KACHEL + j + 0.5f) * skala;
+        }
+    }
+    faStrecke(&l->quellen, LUPE_PIXEL, x, y, NULL, NULL, werte);
+
+    // Auf (a1 + a2)^2 bezogen, sonst wären die Streifen an den Spalten
+    // überstrahlt und weiter weg zu dunkel.
+    const FaQuellen* q = &l->quellen;
+    for (int p = 0; p < LUPE_PIXEL; p++) {
+        if (x[p] < l->xWand) {
+            werte[p] = 0.0f;
+            out[p] = RAYWHITE;
+            continue;
+        }
+        float dx = x[p] - q->x, dy1 = y[p] - q->y1, dy2 = y[p] - q->y2;
+        float a = 1.0f / sqrtf(sqrtf(dx * dx + dy1 * dy1) + 1e-3f) + 1.0f / sqrtf(sqrtf(dx * dx + dy2 * dy2) + 1e-3f);
+        werte[p] /= a * a;
+        unsigned char v = LinearToSrgb(werte[p]);
+        out[p] = (Color){v, v, v, 255};
+    }
+}
+
+typedef struct {
+    const Lupe* l;
+    int begin;                      // erster Eintrag von fehlend in diesem Stück
+} LupeStueck;
+
+static void LupeKachelnRechnen(void* ctx, int begin, int end) {
+    const LupeStueck* s = ctx;
+    for (int i = begin; i < end; i++) {
+        LupeKachelRechnen(s->l, s->l->fehlend[s->begin + i].kachel, s->l->farben + (size_t)i * LUPE_PIXEL);
+    }
+}
+
+// Scheibenarbeit über die sortierte Liste fehlend: Plätze belegen, im Pool
+// rechnen, Texturen im Render-Thread hochladen.
+static void LupeScheibe(void* ctx, int begin, int end) {
+    Lupe* l = ctx;
+    int n = end - begin;
+    if (l->farbenKacheln < n) {
+        free(l->farben);
+        l->farbenKacheln = n;
+        l->farben = malloc((size_t)n * LUPE_PIXEL * sizeof(Color));
+    }
+    for (int i = begin; i < end; i++) {
+        int k = LupePlatz(l);
+        LupeKachel* kachel = &l->kacheln[k];
+        kachel->schluessel = l->fehlend[i].schluessel;
+        kachel->benutzt = l->frame;
+        if (kachel->werte == NULL) kachel->werte = malloc(LUPE_PIXEL * sizeof(float));
+        l->fehlend[i].kachel = k;
+    }
+
+    LupeStueck stueck = {l, begin};
+    ParallelFor(n, 1, LupeKachelnRechnen, &stueck);
+
+    for (int i = begin; i < end; i++) {
+        int k = l->fehlend[i].kachel;
+        LupeKachel* kachel = &l->kacheln[k];
+        Color* pixel = l->farben + (size_t)(i - begin) * LUPE_PIXEL;
+        if (kachel->textur.id == 0) {
+            Image bild = {pixel, LUPE_KACHEL, LUPE_KACHEL, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+            kachel->textur = LoadTextureFromImage(bild);
+        } else {
+            UpdateTexture(kachel->textur, pixel);
+        }
+        LupeEinhaengen(l, k);
+    }
+    l->gerechnet += n;
+    l->fehlschlaege += n;
+}
+
+static int LupeAbrunden(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static int LupeFehlendVergleich(const void* a, const void* b) {
+    float d = ((const LupeFehlend*)a)->abstand - ((const LupeFehlend*)b)->abstand;
+    return (d > 0.0f) - (d < 0.0f);
+}
+
+static void LupeZurueck(Lupe* l, Vector2 bildmitte) {
+    l->zoom = 0;
+    l->mitte = bildmitte;
+}
+
+// Neue Stufe, der Fensterpunkt unter dem Bildpunkt p bleibt stehen.
+static void LupeZoomen(Lupe* l, int zoom, Vector2 p, Vector2 bildmitte) {
+    if (zoom < 0) zoom = 0;
+    if (zoom > LUPE_ZOOM_MAX) zoom = LUPE_ZOOM_MAX;
+    float alt = (float)(1 << l->zoom), neu = (float)(1 << zoom);
+    l->mitte.x += (p.x - bildmitte.x) * (1.0f / alt - 1.0f / neu);
+    l->mitte.y += (p.y - bildmitte.y) * (1.0f / alt - 1.0f / neu);
+    l->zoom = zoom;
+}
+
+static void LupeMaus(Lupe* l, int x0, int width, int hoehe, Vector2 bildmitte) {
+    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) l->ziehen = false;
+    if (IsKeyPressed(KEY_C)) LupeZurueck(l, bildmitte);
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) LupeZoomen(l, l->zoom + 1, bildmitte, bildmitte);
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) LupeZoomen(l, l->zoom - 1, bildmitte, bildmitte);
+    if (active_id >= 0) return;
+
+    Vector2 maus = GetMousePosition();
+    bool drin = maus.x >= x0 && maus.x < width && maus.y >= 0 && maus.y < hoehe;
+    float rad = GetMouseWheelMove();
+    if (drin && rad != 0.0f) LupeZoomen(l, l->zoom + (rad > 0.0f ? 1 : -1), maus, bildmitte);
+    if (drin && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) l->ziehen = true;
+    if (l->ziehen && IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+        Vector2 d = GetMouseDelta();
+        float skala = (float)(1 << l->zoom);
+        l->mitte.x -= d.x / skala;
+        l->mitte.y -= d.y / skala;
+    }
+}
+
+void DrawLupe(int width, int height, AppState* state) {
+    Lupe* l = &lupe;
+    if (l->kacheln == NULL) LupeAnlegen(l);
+    FaWaehlen();
+    InitSrgbTabelle();
+
+    Spalt spalt = SpaltGeometrie(width, height, state);
+    int x0 = spalt.xSpalt + 3;
+    int hoehe = height - PANEL_HOEHE > 1 ? height - PANEL_HOEHE : 1;
+    if (x0 >= width) return;
+    Vector2 bildmitte = {(x0 + width) * 0.5f, hoehe * 0.5f};
+    if (l->width != width || l->height != height) {
+        LupeZurueck(l, bildmitte);
+        l->width = width;
+        l->height = height;
+    }
+    LupeMaus(l, x0, width, hoehe, bildmitte);
+    l->frame++;
+
+    FeldParameter p = {state->lambda, state->gitterD, state->winkel, width, height};
+    l->quellen = FaQuellenVon(&p);
+    l->xWand = l->quellen.x;
+
+    // Bildpixel c der Stufe zeigt den Fensterpunkt (c + 0.5) / skala, Bildpixel
+    // c liegt bei c + ox auf dem Schirm.
+    int skala = 1 << l->zoom;
+    int ox = (int)lroundf(bildmitte.x - l->mitte.x * skala);
+    int oy = (int)lroundf(bildmitte.y - l->mitte.y * skala);
+    int tx0 = LupeAbrunden(x0 - ox, LUPE_KACHEL), tx1 = LupeAbrunden(width - 1 - ox, LUPE_KACHEL);
+    int ty0 = LupeAbrunden(-oy, LUPE_KACHEL), ty1 = LupeAbrunden(hoehe - 1 - oy, LUPE_KACHEL);
+    int sichtbar = (tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+    LupeSchluessel schluessel = {l->zoom, 0, 0, state->lambda, state->gitterD, state->winkel, width, height};
+
+    if (l->fehlendKapazitaet < sichtbar) {
+        free(l->fehlend);
+        l->fehlendKapazitaet = sichtbar;
+        l->fehlend = malloc((size_t)sichtbar * sizeof(LupeFehlend));
+    }
+    l->fehlendAnzahl = 0;
+    int imCache = 0;
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            schluessel.tx = tx;
+            schluessel.ty = ty;
+            int k = LupeSuchen(l, &schluessel);
+            if (k >= 0) {
+                if (l->kacheln[k].benutzt < l->frame - 1) l->treffer++;
+                l->kacheln[k].benutzt = l->frame;
+                imCache++;
+                continue;
+            }
+            float dx = tx * LUPE_KACHEL + ox + LUPE_KACHEL * 0.5f - bildmitte.x;
+            float dy = ty * LUPE_KACHEL + oy + LUPE_KACHEL * 0.5f - bildmitte.y;
+            l->fehlend[l->fehlendAnzahl++] = (LupeFehlend){schluessel, dx * dx + dy * dy, -1};
+        }
+    }
+
+    // Von der Mitte nach außen; mehr als in den Cache passt, ohne Sichtbares
+    // zu verdrängen, wird nicht gerechnet.
+    qsort(l->fehlend, (size_t)l->fehlendAnzahl, sizeof(LupeFehlend), LupeFehlendVergleich);
+    if (l->fehlendAnzahl > l->kapazitaet - imCache) l->fehlendAnzahl = l->kapazitaet - imCache;
+    l->gerechnet = 0;
+    if (l->fehlendAnzahl > 0) {
+        double start = NowSeconds();
+        ScheibenarbeitStarten(&l->arbeit, l->fehlendAnzahl, LupeScheibe, l);
+        ScheibenarbeitWeiter(&l->arbeit);
+        l->rechenzeit = NowSeconds() - start;
+    }
+
+    BeginScissorMode(x0, 0, width - x0, hoehe);
+    int fehlt = 0;
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            schluessel.zoom = l->zoom;
+            schluessel.tx = tx;
+            schluessel.ty = ty;
+            Rectangle ziel = {(float)(tx * LUPE_KACHEL + ox), (float)(ty * LUPE_KACHEL + oy), LUPE_KACHEL, LUPE_KACHEL};
+            int k = LupeSuchen(l, &schluessel);
+            if (k >= 0) {
+                DrawTexture(l->kacheln[k].textur, (int)ziel.x, (int)ziel.y, WHITE);
+                continue;
+            }
+            fehlt++;
+            if (l->zoom == 0) continue;
+
+            // Platzhalter: das passende Viertel der Kachel eine Stufe gröber.
+            schluessel.zoom = l->zoom - 1;
+            schluessel.tx = LupeAbrunden(tx, 2);
+            schluessel.ty = LupeAbrunden(ty, 2);
+            k = LupeSuchen(l, &schluessel);
+            if (k < 0) continue;
+            l->kacheln[k].benutzt = l->frame;
+            const float h = LUPE_KACHEL / 2;
+            Rectangle quelle = {(tx - 2 * schluessel.tx) * h, (ty - 2 * schluessel.ty) * h, h, h};
+            DrawTexturePro(l->kacheln[k].textur, quelle, ziel, (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+        }
+    }
+    DrawCircleV((Vector2){l->quellen.x * skala + ox, l->quellen.y1 * skala + oy}, 4.0f, DARKBLUE);
+    DrawCircleV((Vector2){l->quellen.x * skala + ox, l->quellen.y2 * skala + oy}, 4.0f, DARKBLUE);
+    EndScissorMode();
+
+    long aufgedeckt = l->treffer + l->fehlschlaege;
+    overlay_text(TextFormat("Lupe %dx (Stufe %d/%d) um (%.2f, %.2f) [Rad, +/-: Zoom, Ziehen: verschieben, C: zurück]",
+                            skala, l->zoom, LUPE_ZOOM_MAX, l->mitte.x, l->mitte.y));
+    overlay_text(TextFormat("Kacheln %d px: %d sichtbar, %d fehlen, %d gerechnet in %.2f ms", LUPE_KACHEL, sichtbar,
+                            fehlt, l->gerechnet, l->gerechnet > 0 ? l->rechenzeit * 1e3 : 0.0));
+    overlay_text(TextFormat("Kachelcache: %d/%d Kacheln, %.1f MB, aus Cache %.0f%%, verdrängt %ld", l->belegt,
+                            l->kapazitaet, l->belegt * (double)LUPE_KACHEL_BYTES / (1024.0 * 1024.0),
+                            aufgedeckt > 0 ? 100.0 * l->treffer / aufgedeckt : 0.0, l->verdraengt));
+
+    Vector2 maus = GetMousePosition();
+    if (maus.x >= x0 && maus.x < width && maus.y >= 0 && maus.y < hoehe) {
+        int cx = (int)maus.x - ox, cy = (int)maus.y - oy;
+        schluessel = (LupeSchluessel){l->zoom, LupeAbrunden(cx, LUPE_KACHEL), LupeAbrunden(cy, LUPE_KACHEL),
+                                      state->lambda, state->gitterD, state->winkel, width, height};
+        int k = LupeSuchen(l, &schluessel);
+        if (k >= 0) {
+            int i = cx - schluessel.tx * LUPE_KACHEL, j = cy - schluessel.ty * LUPE_KACHEL;
+            overlay_text(TextFormat("  (%.3f, %.3f): I / (a1 + a2)^2 = %.3f", (cx + 0.5f) / skala,
+                                    (cy + 0.5f) / skala, l->kacheln[k].werte[j * LUPE_KACHEL + i]));
+        }
+    }
+}
+
+void UnloadLupe(void) {
+    Lupe* l = &lupe;
+    for (int i = 0; i < l->belegt; i++) {
+        free(l->kacheln[i].werte);
+        if (l->kacheln[i].textur.id != 0) UnloadTexture(l->kacheln[i].textur);
+    }
+    free(l->kacheln);
+    free(l->fehlend);
+    free(l->farben);
+    memset(l, 0, sizeof(*l));
+}
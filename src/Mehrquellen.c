@@ -0,0 +1,518 @@
+// Mehrquellen.c
+// Beliebig viele frei gesetzte, gleichphasige Punktquellen statt der zwei
+// Spalte. Linksklick setzt eine Quelle oder zieht eine vorhandene,
+// Rechtsklick entfernt sie, C stellt die beiden Spalte wieder her.
+//
+// Wellenberg i von Quelle A (Radius ri = i lambda) schneidet Wellenberg j von
+// B im Abstand D nur für |ri - rj| <= D <= ri + rj. Statt alle (i, j) aller
+// Paare zu prüfen, läuft pro Paar ein Sweep über die Ringe von A, die den
+// sichtbaren Bereich überhaupt treffen. Auf den sichtbaren Bögen eines Rings
+// ist der Abstand zu B durch die Bogenenden und die Richtung zu B (bzw. von
+// B weg) begrenzt, das ergibt das Intervall der j, die noch einen sichtbaren
+// Punkt liefern können. Der Aufwand folgt so der Zahl sichtbarer Kreuzungen.
+//
+// Die Kreuzungen jedes Paars bleiben als Bitpositionen gespeichert. Zwei
+// Bitmasken mit einem Bit je Pixel (bei 4K 1 MB, bleibt im Cache) sammeln
+// sie: eine für die ruhenden Paare, eine für die Paare der gezogenen Quelle.
+// Beim Ziehen werden nur deren Paare neu gerechnet und die zweite Maske neu
+// gesetzt; ein Zähler je Pixel zum Austragen wäre bei 4K 16 MB mit zufälligen
+// Zugriffen und damit langsamer als die ganze Rechnung. Die Textur (Grau und
+// Alpha, beim Zeichnen rot getönt) entsteht aus beiden Masken, jeder Punkt
+// als 2x2-Fleck.
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rlgl.h"
+
+#define MQ_MAX 32                   // Quellen
+#define MQ_FANG 15.0f               // Pixel, in denen ein Klick eine Quelle trifft
+#define MQ_FEHLER 0.25f             // erlaubte Sehnenabweichung der Ringe in Pixel
+#define MQ_MAX_SEHNE 64.0f
+
+typedef struct {
+    float von, bis;                 // Winkel in [0, 2 pi]
+} MqBogen;
+
+typedef struct {
+    int* punkte;                    // Bit der linken oberen Ecke des 2x2-Flecks
+    int anzahl, kapazitaet;
+} MqPaar;
+
+typedef struct {
+    Vector2* punkte;                // Sehnen als Punktpaare für RL_LINES
+    int anzahl, kapazitaet;
+} MqRinge;
+
+typedef struct {
+    Vector2 quellen[MQ_MAX];
+    int n;
+    int gezogen;                    // -1: keine
+    MqPaar paare[MQ_MAX][MQ_MAX];   // nur [a][b] mit a < b belegt
+
+    int breite, hoehe;              // sichtbarer Bereich über dem Regler-Panel
+    int woerter;                    // 64-Bit-Wörter je Maskenzeile
+    uint64_t* ruhend;
+    uint64_t* bewegt;               // Paare der Quelle bewegtVon
+    int bewegtVon;                  // -1: alle Paare in ruhend
+    unsigned short* maske;          // Grau und Alpha je Pixel
+    Texture2D textur;
+    bool texturNeu;
+    float lambda;
+
+    MqRinge ringe[MQ_MAX];          // je Quelle, parallel gebaut
+    bool ringeNeu;
+
+    int width, height;
+    double rechenzeit, maskenzeit;
+    int neuePaare;
+} Mehrquellen;
+
+static Mehrquellen mehrquellen = {.gezogen = -1, .bewegtVon = -1};
+
+static MqPaar* MqPaarVon(Mehrquellen* m, int a, int b) {
+    return a < b ? &m->paare[a][b] : &m->paare[b][a];
+}
+
+static bool MqSichtbar(float x, float y, float breite, float hoehe) {
+    return x >= 0.0f && x < breite && y >= 0.0f && y < hoehe;
+}
+
+// Bögen des Kreises (c, r) in [0, breite) x [0, hoehe), höchstens fünf
+// (vier Ecken abgeschnitten, dazu die Naht bei Winkel 0).
+static int MqBoegen(Vector2 c, float r, float breite, float hoehe, MqBogen* boegen) {
+    float w[10];
+    int n = 0;
+    w[n++] = 0.0f;
+    w[n++] = 2.0f * PI;
+
+    float kanteX[2] = {0.0f, breite}, kanteY[2] = {0.0f, hoehe};
+    for (int k = 0; k < 2; k++) {
+        float u = (kanteX[k] - c.x) / r;
+        if (fabsf(u) < 1.0f) {
+            float a = acosf(u);
+            w[n++] = a;
+            w[n++] = 2.0f * PI - a;
+        }
+        float v = (kanteY[k] - c.y) / r;
+        if (fabsf(v) < 1.0f) {
+            float a = asinf(v);
+            w[n++] = a < 0.0f ? a + 2.0f * PI : a;
+            w[n++] = PI - a;
+        }
+    }
+    for (int i = 1; i < n; i++) {
+        float t = w[i];
+        int j = i;
+        for (; j > 0 && w[j - 1] > t; j--) w[j] = w[j - 1];
+        w[j] = t;
+    }
+
+    int anzahl = 0;
+    for (int i = 0; i + 1 < n; i++) {
+        if (w[i + 1] - w[i] < 1e-6f) continue;
+        float mitte = 0.5f * (w[i] + w[i + 1]);
+        if (!MqSichtbar(c.x + r * cosf(mitte), c.y + r * sinf(mitte), breite, hoehe)) continue;
+        if (anzahl > 0 && boegen[anzahl - 1].bis == w[i]) boegen[anzahl - 1].bis = w[i + 1];
+        else boegen[anzahl++] = (MqBogen){w[i], w[i + 1]};
+    }
+    return anzahl;
+}
+
+// Kleinster und größter Abstand eines Punkts zum Rechteck.
+static void MqAbstaende(Vector2 p, float breite, float hoehe, float* rMin, float* rMax) {
+    float dx = p.x < 0.0f ? -p.x : (p.x > breite ? p.x - breite : 0.0f);
+    float dy = p.y < 0.0f ? -p.y : (p.y > hoehe ? p.y - hoehe : 0.0f);
+    float fx = fmaxf(fabsf(p.x), fabsf(p.x - breite));
+    float fy = fmaxf(fabsf(p.y), fabsf(p.y - hoehe));
+    *rMin = sqrtf(dx * dx + dy * dy);
+    *rMax = sqrtf(fx * fx + fy * fy);
+}
+
+static bool MqWinkelIm(float w, MqBogen b) {
+    return (w >= b.von && w <= b.bis) || (w + 2.0f * PI >= b.von && w + 2.0f * PI <= b.bis);
+}
+
+static void MqPunkt(MqPaar* p, int index) {
+    if (p->anzahl == p->kapazitaet) {
+        p->kapazitaet = p->kapazitaet ? 2 * p->kapazitaet : 1024;
+        p->punkte = realloc(p->punkte, p->kapazitaet * sizeof(int));
+    }
+    p->punkte[p->anzahl++] = index;
+}
+
+static void MqKreuzungen(Mehrquellen* m, int a, int b) {
+    MqPaar* p = MqPaarVon(m, a, b);
+    p->anzahl = 0;
+
+    const int breite = m->breite, hoehe = m->hoehe, zeile = 64 * m->woerter;
+    const float fb = (float)breite, fh = (float)hoehe;
+    const float lambda = m->lambda;
+    Vector2 qa = m->quellen[a], qb = m->quellen[b];
+    float ex = qb.x - qa.x, ey = qb.y - qa.y;
+    float d = sqrtf(ex * ex + ey * ey);
+    if (d < 1e-3f) return;
+    ex /= d;
+    ey /= d;
+    float winkelB = atan2f(ey, ex);
+    if (winkelB < 0.0f) winkelB += 2.0f * PI;
+    float winkelWeg = winkelB < PI ? winkelB + PI : winkelB - PI;
+
+    float rMinA, rMaxA, rMinB, rMaxB;
+    MqAbstaende(qa, fb, fh, &rMinA, &rMaxA);
+    MqAbstaende(qb, fb, fh, &rMinB, &rMaxB);
+    int iVon = (int)ceilf(rMinA / lambda), iBis = (int)floorf(rMaxA / lambda);
+    if (iVon < 1) iVon = 1;
+
+    MqBogen boegen[5];
+    for (int i = iVon; i <= iBis; i++) {
+        float ri = i * lambda;
+        int nBoegen = MqBoegen(qa, ri, fb, fh, boegen);
+        if (nBoegen == 0) continue;
+
+        // cos des Winkels zwischen Bogenpunkt und Richtung zu B, über alle Bögen.
+        float cMin = 1.0f, cMax = -1.0f;
+        for (int k = 0; k < nBoegen; k++) {
+            float c0 = cosf(boegen[k].von - winkelB), c1 = cosf(boegen[k].bis - winkelB);
+            cMin = fminf(cMin, fminf(c0, c1));
+            cMax = fmaxf(cMax, fmaxf(c0, c1));
+            if (MqWinkelIm(winkelB, boegen[k])) cMax = 1.0f;
+            if (MqWinkelIm(winkelWeg, boegen[k])) cMin = -1.0f;
+        }
+        float q = ri * ri + d * d;
+        float rjVon = sqrtf(fmaxf(q - 2.0f * ri * d * cMax, 0.0f));
+        float rjBis = sqrtf(q - 2.0f * ri * d * cMin);
+        int jVon = (int)ceilf(fmaxf(rjVon, rMinB) / lambda);
+        int jBis = (int)floorf(fminf(rjBis, rMaxB) / lambda);
+        if (jVon < 1) jVon = 1;
+
+        for (int j = jVon; j <= jBis; j++) {
+            float rj = j * lambda;
+            float s = (ri * ri - rj * rj + d * d) / (2.0f * d);
+            float h2 = ri * ri - s * s;
+            if (h2 < 0.0f) continue;
+            float h = sqrtf(h2);
+            float mx = qa.x + s * ex, my = qa.y + s * ey;
+            for (int seite = -1; seite <= 1; seite += 2) {
+                float x = mx - seite * h * ey, y = my + seite * h * ex;
+                if (!MqSichtbar(x, y, fb, fh)) continue;
+                int px = (int)(x - 0.5f), py = (int)(y - 0.5f);
+                px = px < 0 ? 0 : (px > breite - 1 ? breite - 1 : px);
+                py = py < 0 ? 0 : (py > hoehe - 1 ? hoehe - 1 : py);
+                MqPunkt(p, py * zeile + px);
+            }
+        }
+    }
+}
+
+static void MqBitsSetzen(uint64_t* bits, const MqPaar* p) {
+    for (int i = 0; i < p->anzahl; i++) bits[p->punkte[i] >> 6] |= (uint64_t)1 << (p->punkte[i] & 63);
+}
+
+// ruhend aus allen Paaren ohne Quelle k, bewegt aus denen mit k.
+static void MqMaskenBauen(Mehrquellen* m, int k) {
+    size_t woerter = (size_t)m->woerter * m->hoehe;
+    memset(m->ruhend, 0, woerter * sizeof(uint64_t));
+    memset(m->bewegt, 0, woerter * sizeof(uint64_t));
+    for (int a = 0; a < m->n; a++) {
+        for (int b = a + 1; b < m->n; b++) MqBitsSetzen(a == k || b == k ? m->bewegt : m->ruhend, &m->paare[a][b]);
+    }
+    m->bewegtVon = k;
+    m->texturNeu = true;
+}
+
+typedef struct {
+    Mehrquellen* m;
+    int a[MQ_MAX * MQ_MAX], b[MQ_MAX * MQ_MAX];
+} MqAuftrag;
+
+static void MqPaareRechnen(void* ctx, int begin, int end) {
+    MqAuftrag* auftrag = (MqAuftrag*)ctx;
+    for (int t = begin; t < end; t++) MqKreuzungen(auftrag->m, auftrag->a[t], auftrag->b[t]);
+}
+
+// Rechnet alle Paare mit Quelle k neu, k < 0: alle Paare.
+static void MqNeuRechnen(Mehrquellen* m, int k) {
+    double start = NowSeconds();
+    static MqAuftrag auftrag;
+    int anzahl = 0;
+    auftrag.m = m;
+
+    for (int a = 0; a < m->n; a++) {
+        for (int b = a + 1; b < m->n; b++) {
+            if (k >= 0 && a != k && b != k) continue;
+            auftrag.a[anzahl] = a;
+            auftrag.b[anzahl] = b;
+            anzahl++;
+        }
+    }
+
+    ParallelFor(anzahl, 1, MqPaareRechnen, &auftrag);
+
+    // Zieht der Nutzer dieselbe Quelle weiter, bleibt ruhend unverändert.
+    if (k >= 0 && k == m->bewegtVon) {
+        memset(m->bewegt, 0, (size_t)m->woerter * m->hoehe * sizeof(uint64_t));
+        for (int t = 0; t < anzahl; t++) MqBitsSetzen(m->bewegt, &m->paare[auftrag.a[t]][auftrag.b[t]]);
+        m->texturNeu = true;
+    } else {
+        MqMaskenBauen(m, k);
+    }
+
+    m->neuePaare = anzahl;
+    m->rechenzeit = NowSeconds() - start;
+    m->ringeNeu = true;
+}
+
+// Grau und Alpha für 8 Pixel aus einem Byte der Maske.
+static unsigned short mqSpreizung[256][8];
+
+static void MqMaskeZeilen(void* ctx, int begin, int end) {
+    Mehrquellen* m = (Mehrquellen*)ctx;
+    const int w = m->woerter;
+
+    for (int y = begin; y < end; y++) {
+        const uint64_t* r0 = m->ruhend + (size_t)y * w;
+        const uint64_t* b0 = m->bewegt + (size_t)y * w;
+        const uint64_t* r1 = y > 0 ? r0 - w : r0;
+        const uint64_t* b1 = y > 0 ? b0 - w : b0;
+        unsigned short* aus = m->maske + (size_t)y * m->breite;
+        uint64_t uebertrag = 0;
+
+        for (int i = 0; i < w; i++) {
+            // Ein Bit färbt sein Pixel, das rechts daneben und die beiden darunter.
+            uint64_t bits = r0[i] | b0[i] | r1[i] | b1[i];
+            uint64_t fleck = bits | bits << 1 | uebertrag;
+            uebertrag = bits >> 63;
+            for (int byte = 0; byte < 8; byte++) {
+                int x = 64 * i + 8 * byte;
+                if (x >= m->breite) break;
+                int anzahl = m->breite - x < 8 ? m->breite - x : 8;
+                memcpy(aus + x, mqSpreizung[(fleck >> (8 * byte)) & 255], anzahl * sizeof(unsigned short));
+            }
+        }
+    }
+}
+
+static void MqMaskeFuellen(Mehrquellen* m) {
+    if (mqSpreizung[255][0] == 0) {
+        for (int v = 0; v < 256; v++) {
+            for (int b = 0; b < 8; b++) mqSpreizung[v][b] = (v >> b) & 1 ? 0xffff : 0;
+        }
+    }
+    ParallelFor(m->hoehe, 16, MqMaskeZeilen, m);
+}
+
+static void MqRingPunkt(MqRinge* ringe, float x, float y) {
+    if (ringe->anzahl == ringe->kapazitaet) {
+        ringe->kapazitaet = ringe->kapazitaet ? 2 * ringe->kapazitaet : 4096;
+        ringe->punkte = realloc(ringe->punkte, ringe->kapazitaet * sizeof(Vector2));
+    }
+    ringe->punkte[ringe->anzahl++] = (Vector2){x, y};
+}
+
+// Sichtbare Bögen aller Wellenberge, Sehnenlänge wie in Hyperbel.c nach der
+// Krümmung 1 / r gewählt und die Drehung schrittweise multipliziert. Jede
+// Quelle schreibt in ihre eigene Liste, die Quellen laufen im Thread-Pool.
+static void MqRingeQuellen(void* ctx, int begin, int end) {
+    Mehrquellen* m = (Mehrquellen*)ctx;
+    const float fb = (float)m->breite, fh = (float)m->hoehe;
+    MqBogen boegen[5];
+
+    for (int k = begin; k < end; k++) {
+        MqRinge* ringe = &m->ringe[k];
+        Vector2 c = m->quellen[k];
+        ringe->anzahl = 0;
+        float rMin, rMax;
+        MqAbstaende(c, fb, fh, &rMin, &rMax);
+        int iVon = (int)ceilf(rMin / m->lambda), iBis = (int)floorf(rMax / m->lambda);
+        if (iVon < 1) iVon = 1;
+
+        for (int i = iVon; i <= iBis; i++) {
+            float r = i * m->lambda;
+            float sehne = fminf(sqrtf(8.0f * MQ_FEHLER * r), MQ_MAX_SEHNE);
+            int nBoegen = MqBoegen(c, r, fb, fh, boegen);
+            for (int b = 0; b < nBoegen; b++) {
+                int schritte = 1 + (int)((boegen[b].bis - boegen[b].von) * r / sehne);
+                float dw = (boegen[b].bis - boegen[b].von) / schritte;
+                float dc = cosf(dw), ds = sinf(dw);
+                float u = r * cosf(boegen[b].von), v = r * sinf(boegen[b].von);
+                for (int s = 0; s < schritte; s++) {
+                    MqRingPunkt(ringe, c.x + u, c.y + v);
+                    float un = u * dc - v * ds;
+                    v = u * ds + v * dc;
+                    u = un;
+                    MqRingPunkt(ringe, c.x + u, c.y + v);
+                }
+            }
+        }
+    }
+}
+
+static void MqRingeBauen(Mehrquellen* m) {
+    ParallelFor(m->n, 1, MqRingeQuellen, m);
+    m->ringeNeu = false;
+}
+
+static void MqGroesse(Mehrquellen* m, int breite, int hoehe) {
+    m->breite = breite;
+    m->hoehe = hoehe;
+    m->woerter = (breite + 63) / 64;
+    free(m->ruhend);
+    free(m->bewegt);
+    free(m->maske);
+    m->ruhend = malloc((size_t)m->woerter * hoehe * sizeof(uint64_t));
+    m->bewegt = malloc((size_t)m->woerter * hoehe * sizeof(uint64_t));
+    m->maske = calloc((size_t)breite * hoehe, sizeof(unsigned short));
+    m->bewegtVon = -1;
+
+    if (m->textur.id != 0) UnloadTexture(m->textur);
+    Image bild = {m->maske, breite, hoehe, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+    m->textur = LoadTextureFromImage(bild);
+}
+
+static void MqSpalteSetzen(Mehrquellen* m, int width, int height, AppState* state) {
+    Spalt s = SpaltGeometrie(width, height, state);
+    m->quellen[0] = (Vector2){(float)s.xSpalt, (float)s.ySpalt1};
+    m->quellen[1] = (Vector2){(float)s.xSpalt, (float)s.ySpalt2};
+    m->n = 2;
+    m->gezogen = -1;
+}
+
+static void MqEntfernen(Mehrquellen* m, int k) {
+    int letzte = m->n - 1;
+    for (int t = 0; t < m->n; t++) {
+        if (t != k) MqPaarVon(m, k, t)->anzahl = 0;
+    }
+    // Die letzte Quelle rückt auf Platz k, ihre Paare mit ihr.
+    if (k != letzte) {
+        for (int t = 0; t < letzte; t++) {
+            if (t == k) continue;
+            MqPaar tausch = *MqPaarVon(m, k, t);
+            *MqPaarVon(m, k, t) = *MqPaarVon(m, letzte, t);
+            *MqPaarVon(m, letzte, t) = tausch;
+        }
+        m->quellen[k] = m->quellen[letzte];
+    }
+    m->n--;
+    MqMaskenBauen(m, -1);
+    m->ringeNeu = true;
+}
+
+static int MqNaechste(Mehrquellen* m, Vector2 p) {
+    int wahl = -1;
+    float best = MQ_FANG;
+    for (int k = 0; k < m->n; k++) {
+        float abstand = Vector2Distance(p, m->quellen[k]);
+        if (abstand < best) {
+            best = abstand;
+            wahl = k;
+        }
+    }
+    return wahl;
+}
+
+static void MqMaus(Mehrquellen* m) {
+    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) m->gezogen = -1;
+    if (active_id >= 0) return;
+
+    Vector2 maus = GetMousePosition();
+    maus.x = Clamp(maus.x, 0.0f, (float)m->breite - 1.0f);
+    maus.y = Clamp(maus.y, 0.0f, (float)m->hoehe - 1.0f);
+
+    if (m->gezogen >= 0) {
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && !Vector2Equals(maus, m->quellen[m->gezogen])) {
+            m->quellen[m->gezogen] = maus;
+            MqNeuRechnen(m, m->gezogen);
+        }
+        return;
+    }
+    if (GetMousePosition().y >= m->hoehe) return;
+
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        int k = MqNaechste(m, maus);
+        if (k < 0 && m->n < MQ_MAX) {
+            k = m->n++;
+            m->quellen[k] = maus;
+            MqNeuRechnen(m, k);
+        }
+        m->gezogen = k;
+    } else if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
+        int k = MqNaechste(m, maus);
+        if (k >= 0) MqEntfernen(m, k);
+    }
+}
+
+void DrawMehrquellen(int width, int height, AppState* state) {
+    Mehrquellen* m = &mehrquellen;
+
+    bool neu = m->width != width || m->height != height || m->lambda != (float)state->lambda;
+    if (m->n == 0 || IsKeyPressed(KEY_C)) {
+        MqSpalteSetzen(m, width, height, state);
+        neu = true;
+    }
+    if (neu) {
+        if (m->width != width || m->height != height) {
+            MqGroesse(m, width, height - PANEL_HOEHE > 1 ? height - PANEL_HOEHE : 1);
+            for (int k = 0; k < m->n; k++) {
+                m->quellen[k].x = fminf(m->quellen[k].x, width - 1.0f);
+                m->quellen[k].y = fminf(m->quellen[k].y, m->hoehe - 1.0f);
+            }
+        }
+        m->lambda = (float)state->lambda;
+        m->width = width;
+        m->height = height;
+        for (int a = 0; a < MQ_MAX; a++) {
+            for (int b = 0; b < MQ_MAX; b++) m->paare[a][b].anzahl = 0;
+        }
+        MqNeuRechnen(m, -1);
+    }
+    MqMaus(m);
+
+    if (m->ringeNeu) MqRingeBauen(m);
+    rlBegin(RL_LINES);
+    rlColor4ub(LIGHTGRAY.r, LIGHTGRAY.g, LIGHTGRAY.b, 255);
+    int ringPunkte = 0;
+    for (int k = 0; k < m->n; k++) {
+        const MqRinge* ringe = &m->ringe[k];
+        for (int i = 0; i < ringe->anzahl; i++) rlVertex2f(ringe->punkte[i].x, ringe->punkte[i].y);
+        ringPunkte += ringe->anzahl;
+    }
+    rlEnd();
+
+    if (m->texturNeu) {
+        double start = NowSeconds();
+        MqMaskeFuellen(m);
+        UpdateTexture(m->textur, m->maske);
+        m->maskenzeit = NowSeconds() - start;
+        m->texturNeu = false;
+    }
+    DrawTexture(m->textur, 0, 0, RED);
+
+    for (int k = 0; k < m->n; k++) {
+        DrawCircleV(m->quellen[k], 6.0f, k == m->gezogen ? ORANGE : DARKBLUE);
+    }
+
+    int kreuzungen = 0;
+    for (int a = 0; a < m->n; a++) {
+        for (int b = a + 1; b < m->n; b++) kreuzungen += m->paare[a][b].anzahl;
+    }
+    overlay_text(TextFormat("%d Quellen [Links: setzen/ziehen, Rechts: entfernen, C: Spalte]", m->n));
+    overlay_text(TextFormat("%d Kreuzungen, zuletzt %d Paare in %.2f ms, Textur %.2f ms, %d Ringsehnen", kreuzungen,
+                            m->neuePaare, m->rechenzeit * 1000.0, m->maskenzeit * 1000.0, ringPunkte / 2));
+}
+
+void UnloadMehrquellen(void) {
+    Mehrquellen* m = &mehrquellen;
+    for (int a = 0; a < MQ_MAX; a++) {
+        for (int b = 0; b < MQ_MAX; b++) free(m->paare[a][b].punkte);
+    }
+    free(m->ruhend);
+    free(m->bewegt);
+    free(m->maske);
+    if (m->textur.id != 0) UnloadTexture(m->textur);
+    for (int k = 0; k < MQ_MAX; k++) free(m->ringe[k].punkte);
+    memset(m, 0, sizeof(*m));
+    m->gezogen = -1;
+    m->bewegtVon = -1;
+}
@@ -0,0 +1,143 @@
+// Qualitaet.c
+// Regler für die Bildrate: misst Framezeit und Arbeitszeit je Frame und
+// tauscht bei Überlast Qualität gegen Zeit, in Stufen von voll (0) bis
+// QUALITAET_STUFEN - 1. Jede Stufe begrenzt
+// - die Segmente der Wellenberge (DrawCircleSectorLines),
+// - Radius und Zahl der gezeichneten Interferenzpunkte,
+// - die Schirmauflösung (Schirm.c),
+// - die Wellenlängen des Weißlichts; MSAA ist in raylib beim Anlegen des
+//   Fensters festgelegt, das ist die nächste Probenzahl, die sich zur
+//   Laufzeit ändern lässt.
+//
+// Hysterese: eine Stufe runter, wenn die geglättete Framezeit
+// QUALITAET_RUNTER_FRAMES Frames lang über dem 1.1-fachen Ziel liegt, eine
+// hoch erst nach QUALITAET_HOCH_FRAMES Frames mit Arbeit unter dem halben
+// Ziel und Framezeit am Ziel. Die Arbeit endet vor EndDrawing und enthält die
+// Zeit der GPU nicht; erst die Framezeit zeigt, ob die GPU hinterherkommt.
+// Fällt eine Stufe innerhalb von QUALITAET_BEWAEHRT Frames nach dem Aufstieg
+// wieder, verdoppelt sich die Wartezeit für den nächsten Versuch (bis
+// QUALITAET_HOCH_MAX); hält sie so lange, gilt wieder die kurze. Nach jedem
+// Wechsel ruht der Regler QUALITAET_PAUSE Frames. Entscheidungen stehen im
+// Overlay und per TraceLog im Log.
+#include <limits.h>
+
+#define QUALITAET_STUFEN 5
+#define QUALITAET_ZIEL (1.0 / 60.0)
+#define QUALITAET_RUNTER_FRAMES 15
+#define QUALITAET_HOCH_FRAMES 120
+#define QUALITAET_HOCH_MAX (32 * QUALITAET_HOCH_FRAMES)
+#define QUALITAET_BEWAEHRT 600
+#define QUALITAET_PAUSE 30
+
+typedef struct {
+    int ringSegmente;
+    float punktRadius;              // Faktor auf den Radius der Punkte
+    int punktGrenze;                // höchstens so viele Punkte zeichnen
+    int schirmStufe;                // höchste Stufe aus schirmAufloesung
+    int proben;                     // höchstens so viele Wellenlängen
+} QualitaetStufe;
+
+static const QualitaetStufe qualitaetStufen[QUALITAET_STUFEN] = {
+    {100, 1.0f, INT_MAX, 3, 256},
+    {64, 1.0f, 20000, 2, 192},
+    {40, 0.75f, 10000, 1, 128},
+    {24, 0.6f, 5000, 0, 96},
+    {16, 0.5f, 2500, 0, 64},
+};
+
+typedef struct {
+    int stufe;
+    double frameStart;
+    double frameMittel, arbeitMittel;
+    int langsam, schnell, pause;
+    int seitWechsel;
+    bool aufgestiegen;              // letzter Wechsel war hoch und ist noch nicht bewährt
+    int hochFrames[QUALITAET_STUFEN];   // Wartezeit vor dem Aufstieg auf die Stufe, 0: kurze
+    double fehlFrame[QUALITAET_STUFEN]; // geglättete Framezeit, als die Stufe zuletzt fiel
+
+    char entscheidung[96];
+    double entschiedenUm;
+    int wechsel;
+} Qualitaet;
+
+static Qualitaet qualitaet = {0};
+
+static const QualitaetStufe* QualitaetAktuell(void) {
+    return &qualitaetStufen[qualitaet.stufe];
+}
+
+static int QualitaetHochFrames(const Qualitaet* q, int stufe) {
+    return q->hochFrames[stufe] > 0 ? q->hochFrames[stufe] : QUALITAET_HOCH_FRAMES;
+}
+
+static void QualitaetWechseln(Qualitaet* q, int neu, const char* grund) {
+    TraceLog(LOG_INFO, "QUALITAET: Stufe %d -> %d, %s (Frame %.1f ms, Arbeit %.1f ms)", q->stufe, neu, grund,
+             q->frameMittel * 1e3, q->arbeitMittel * 1e3);
+    snprintf(q->entscheidung, sizeof(q->entscheidung), "%d -> %d %s bei Frame %.1f ms, Arbeit %.1f ms", q->stufe,
+             neu, grund, q->frameMittel * 1e3, q->arbeitMittel * 1e3);
+    q->aufgestiegen = neu < q->stufe;
+    q->stufe = neu;
+    q->entschiedenUm = NowSeconds();
+    q->wechsel++;
+    q->langsam = q->schnell = 0;
+    q->seitWechsel = 0;
+    q->pause = QUALITAET_PAUSE;
+}
+
+// Am Anfang jedes Frames.
+static void QualitaetFrameBeginn(void) {
+    qualitaet.frameStart = NowSeconds();
+}
+
+// Vor EndDrawing: Arbeit dieses Frames und Framezeit des letzten auswerten.
+// GetFrameTime enthält das Warten auf den nächsten Frame, zeigt also nur
+// Überlast; Reserve zeigt erst die reine Arbeitszeit.
+static void QualitaetFrameEnde(void) {
+    Qualitaet* q = &qualitaet;
+    double arbeit = NowSeconds() - q->frameStart;
+    double frame = GetFrameTime();
+    q->frameMittel += 0.1 * (frame - q->frameMittel);
+    q->arbeitMittel += 0.1 * (arbeit - q->arbeitMittel);
+
+    if (q->aufgestiegen && ++q->seitWechsel >= QUALITAET_BEWAEHRT) {
+        q->hochFrames[q->stufe] = 0;
+        q->aufgestiegen = false;
+    }
+    if (q->pause > 0) {
+        q->pause--;
+        return;
+    }
+    q->langsam = q->frameMittel > 1.1 * QUALITAET_ZIEL ? q->langsam + 1 : 0;
+    bool reserve = q->arbeitMittel < 0.5 * QUALITAET_ZIEL && q->frameMittel < 1.05 * QUALITAET_ZIEL;
+    q->schnell = reserve ? q->schnell + 1 : 0;
+
+    if (q->langsam >= QUALITAET_RUNTER_FRAMES && q->stufe < QUALITAET_STUFEN - 1) {
+        q->fehlFrame[q->stufe] = q->frameMittel;
+        if (q->aufgestiegen) {
+            int warten = 2 * QualitaetHochFrames(q, q->stufe);
+            q->hochFrames[q->stufe] = warten < QUALITAET_HOCH_MAX ? warten : QUALITAET_HOCH_MAX;
+            TraceLog(LOG_INFO, "QUALITAET: Stufe %d hielt nur %d Frames, nächster Versuch nach %d Frames", q->stufe,
+                     q->seitWechsel, q->hochFrames[q->stufe]);
+        }
+        QualitaetWechseln(q, q->stufe + 1, "runter");
+    } else if (q->stufe > 0 && q->schnell >= QualitaetHochFrames(q, q->stufe - 1)) {
+        QualitaetWechseln(q, q->stufe - 1, "hoch");
+    }
+}
+
+static void QualitaetOverlay(void) {
+    const Qualitaet* q = &qualitaet;
+    const QualitaetStufe* s = QualitaetAktuell();
+    char grenze[16] = "alle";
+    if (s->punktGrenze != INT_MAX) snprintf(grenze, sizeof(grenze), "%d", s->punktGrenze);
+    overlay_text(TextFormat("Qualität %d/%d: Ringe %d Segm., Punkte %s x%.2f, Schirmstufe %d, N %d", q->stufe,
+                            QUALITAET_STUFEN - 1, s->ringSegmente, grenze, s->punktRadius, s->schirmStufe,
+                            s->proben));
+    if (q->wechsel > 0) {
+        overlay_text(TextFormat("  zuletzt %s, vor %.0f s", q->entscheidung, NowSeconds() - q->entschiedenUm));
+    }
+    if (q->stufe > 0 && q->hochFrames[q->stufe - 1] > 0) {
+        overlay_text(TextFormat("  Stufe %d fiel bei Frame %.1f ms, hoch erst nach %d Frames Reserve", q->stufe - 1,
+                                q->fehlFrame[q->stufe - 1] * 1e3, q->hochFrames[q->stufe - 1]));
+    }
+}
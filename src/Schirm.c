@@ -0,0 +1,178 @@
+// Schirm.c
+// Blick auf den Schirm statt von oben: das volle 2D-Muster zweier Lochblenden
+// im Abstand gitterD (oder eines N x N-Lochgitters) auf einem Schirm im
+// Abstand der rechten Fensterkante von der Wand, mit demselben lambda und
+// winkel wie in der Aufsicht. Die Mittelspalte des Schirms ist also genau der
+// rechte Rand der Aufsicht.
+//
+// Zwei Löcher werden exakt als Kugelwellen gerechnet,
+//   I = 1/r1² + 1/r2² + 2 cos(k (r1 - r2) + k d sin phi) / (r1 r2),
+// das Gitter in Fraunhofer-Näherung als Produkt zweier Dirichlet-Kerne
+//   sin²(N k d s / 2) / sin²(k d s / 2),  s = X / R bzw. Y / R + sin phi.
+// Die Schirmauflösung ist unabhängig vom Fenster (bis 4K); die Kerne laufen
+// vektorisiert über die Kacheln aus Feld.c, Puffer und Texturen kommen aus
+// einem FeldPool und werden beim Verschieben der Regler nicht neu angelegt.
+// Gefüllt wird Kachelzeile für Kachelzeile als Scheibenarbeit (Zeitscheibe.c):
+// passt der Schirm nicht ins Frame-Budget, wächst das neue Bild über mehrere
+// Frames von oben über das alte.
+#include <math.h>
+#include <string.h>
+
+static const int schirmAufloesung[][2] = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+#define SCHIRM_STUFEN (int)(sizeof(schirmAufloesung) / sizeof(schirmAufloesung[0]))
+
+typedef struct {
+    FeldPool pool;
+    FeldBild* bild;
+
+    float k, versatz;               // versatz = k d sin phi
+    float sinPhi;
+    float abstand;                  // Wand - Schirm
+    float skala;                    // Modellpixel je Schirmpixel
+    float d;
+    int gitterN;                    // 0: zwei Löcher
+    Scheibenarbeit arbeit;          // Einheit: eine Kachelzeile
+
+    int stufe;
+    int width, height, gebautN;
+    AppState gebaut;
+    double rechenzeit;
+} Schirm;
+
+static Schirm schirm = {0};
+static int schirmStufe = 1;         // mit +/- einstellbar
+static bool schirmGitter = false;   // mit G umschaltbar
+
+static void SchirmLoecherKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Schirm* s = (Schirm*)ctx;
+    const int n = x1 - x0;
+    const float l2 = s->abstand * s->abstand;
+    const float yy = (y + 0.5f - 0.5f * s->bild->hoehe) * s->skala;
+    const float dy1 = yy + 0.5f * s->d, dy2 = yy - 0.5f * s->d;
+    const float norm = 0.25f * l2;
+    float intensitaet[FELD_TILE];
+
+    for (int i = 0; i < n; i++) {
+        float xx = (x0 + i + 0.5f - 0.5f * s->bild->breite) * s->skala;
+        float q = l2 + xx * xx;
+        float r1 = sqrtf(q + dy1 * dy1), r2 = sqrtf(q + dy2 * dy2);
+        float a1 = 1.0f / r1, a2 = 1.0f / r2;
+        float c = FastCos(s->k * (r1 - r2) + s->versatz);
+        intensitaet[i] = norm * (a1 * a1 + a2 * a2 + 2.0f * a1 * a2 * c);
+    }
+    for (int i = 0; i < n; i++) {
+        unsigned char v = LinearToSrgb(intensitaet[i]);
+        out[i] = (Color){v, v, v, 255};
+    }
+}
+
+// |sum_n exp(i n a)|² / N² für a = k d s. Das kleine eps in Zähler und Nenner
+// liefert am Hauptmaximum (beide Sinus 0) den Grenzwert 1 ohne Verzweigung.
+static inline float SchirmDirichlet(float a, float nf) {
+    float sh = FastSin(0.5f * a), sn = FastSin(0.5f * nf * a);
+    return (sn * sn + 1e-20f) / (nf * nf * sh * sh + 1e-20f);
+}
+
+static void SchirmGitterKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Schirm* s = (Schirm*)ctx;
+    const int n = x1 - x0;
+    const float l2 = s->abstand * s->abstand;
+    const float yy = (y + 0.5f - 0.5f * s->bild->hoehe) * s->skala;
+    const float kd = s->k * s->d;
+    const float nf = (float)s->gitterN;
+    float intensitaet[FELD_TILE];
+
+    for (int i = 0; i < n; i++) {
+        float xx = (x0 + i + 0.5f - 0.5f * s->bild->breite) * s->skala;
+        float r2 = l2 + xx * xx + yy * yy;
+        float inv = 1.0f / sqrtf(r2);
+        float fx = SchirmDirichlet(kd * xx * inv, nf);
+        float fy = SchirmDirichlet(kd * (yy * inv + s->sinPhi), nf);
+        intensitaet[i] = fx * fy * l2 / r2;
+    }
+    for (int i = 0; i < n; i++) {
+        unsigned char v = LinearToSrgb(intensitaet[i]);
+        out[i] = (Color){v, v, v, 255};
+    }
+}
+
+static void SchirmKachelzeilen(void* ctx, int begin, int end) {
+    Schirm* s = (Schirm*)ctx;
+    FeldBild* b = s->bild;
+    FeldKachelzeilenFuellen(b->pixels, b->breite, b->hoehe, begin, end,
+                            s->gitterN > 0 ? SchirmGitterKernel : SchirmLoecherKernel, s);
+}
+
+void DrawSchirm(int width, int height, AppState* state, int gitterN) {
+    Schirm* s = &schirm;
+
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        if (schirmStufe < SCHIRM_STUFEN - 1) schirmStufe++;
+    }
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        if (schirmStufe > 0) schirmStufe--;
+    }
+    if (IsKeyPressed(KEY_G)) schirmGitter = !schirmGitter;
+    if (!schirmGitter) gitterN = 0;
+
+    // Der Qualitätsregler kann die gewählte Stufe nach unten begrenzen.
+    int stufe = schirmStufe < QualitaetAktuell()->schirmStufe ? schirmStufe : QualitaetAktuell()->schirmStufe;
+    Spalt spalt = SpaltGeometrie(width, height, state);
+    int x0 = spalt.xSpalt + 3;
+
+    if (s->bild == NULL || s->stufe != stufe || s->gebautN != gitterN || s->width != width ||
+        s->height != height || s->gebaut.lambda != state->lambda || s->gebaut.gitterD != state->gitterD ||
+        s->gebaut.winkel != state->winkel) {
+        int breite = schirmAufloesung[stufe][0], hoehe = schirmAufloesung[stufe][1];
+        double phi = (state->winkel - 90) * PI / 180.0;
+
+        s->bild = FeldBildAusPool(&s->pool, x0, breite, hoehe);
+        s->k = (float)(2.0 * PI / state->lambda);
+        s->sinPhi = (float)sin(phi);
+        s->versatz = s->k * state->gitterD * s->sinPhi;
+        s->abstand = (float)(width - spalt.xSpalt);
+        s->skala = (float)height / hoehe;
+        s->d = (float)state->gitterD;
+        s->gitterN = gitterN;
+        ScheibenarbeitStarten(&s->arbeit, (hoehe + FELD_TILE - 1) / FELD_TILE, SchirmKachelzeilen, s);
+
+        s->stufe = stufe;
+        s->gebautN = gitterN;
+        s->width = width;
+        s->height = height;
+        s->gebaut = *state;
+    }
+
+    if (!ScheibenarbeitFertig(&s->arbeit)) {
+        int zeile0 = s->arbeit.fertig;
+        ScheibenarbeitWeiter(&s->arbeit);
+        int y0 = zeile0 * FELD_TILE, y1 = s->arbeit.fertig * FELD_TILE;
+        if (y1 > s->bild->hoehe) y1 = s->bild->hoehe;
+        UpdateTextureRec(s->bild->texture, (Rectangle){0, (float)y0, (float)s->bild->breite, (float)(y1 - y0)},
+                         s->bild->pixels + (size_t)y0 * s->bild->breite);
+        s->rechenzeit = s->arbeit.dauer;
+    }
+
+    // Schirm mit festem Seitenverhältnis in den Bereich rechts der Wand.
+    float zielB = (float)(width - x0), zielH = (float)(height - PANEL_HOEHE);
+    float massstab = fminf(zielB / s->bild->breite, zielH / s->bild->hoehe);
+    Rectangle quelle = {0, 0, (float)s->bild->breite, (float)s->bild->hoehe};
+    Rectangle ziel = {x0 + 0.5f * (zielB - massstab * s->bild->breite), 0.5f * (zielH - massstab * s->bild->hoehe),
+                      massstab * s->bild->breite, massstab * s->bild->hoehe};
+    DrawTexturePro(s->bild->texture, quelle, ziel, (Vector2){0, 0}, 0.0f, WHITE);
+
+    overlay_text(TextFormat("Schirm %dx%d [+/-], %s [G], %.1f ms, %.0f MPixel/s", s->bild->breite, s->bild->hoehe,
+                            gitterN > 0 ? TextFormat("Gitter %dx%d", gitterN, gitterN) : "zwei Löcher",
+                            s->rechenzeit * 1000.0,
+                            (double)s->bild->breite * fminf(s->bild->hoehe, FELD_TILE * s->arbeit.fertig) /
+                                s->rechenzeit * 1e-6));
+    if (s->arbeit.frames > 1) {
+        overlay_text(TextFormat("  %s %d%% nach %d Frames", ScheibenarbeitFertig(&s->arbeit) ? "fertig" : "bisher",
+                                100 * s->arbeit.fertig / s->arbeit.gesamt, s->arbeit.frames));
+    }
+}
+
+void UnloadSchirm(void) {
+    FreeFeldPool(&schirm.pool);
+    memset(&schirm, 0, sizeof(schirm));
+}
@@ -0,0 +1,263 @@
+// Schroedinger.c
+// Gaußsches Elektronen-Wellenpaket durch die Spaltwand, gelöst mit der
+// Split-Step-Fourier-Methode: Ortsraumschritt (Wand und absorbierender Rand
+// als Maske), FFT, kinetischer Phasenfaktor, inverse FFT, Ortsraumschritt.
+// Einheiten: Pixel, hbar = m = 1. Die de-Broglie-Wellenlänge ist lambda,
+// die Flugrichtung folgt winkel wie bei der ebenen Welle in DrawSinAndWall.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define QUANT_GRID_MIN 256
+#define QUANT_GRID_MAX 2048
+#define QUANT_PX_PER_STEP 1.5       // Weg des Paketzentrums pro Teilschritt
+#define QUANT_STEPS_PER_FRAME 2     // kleiner als die Wanddicke, sonst tunnelt das Paket
+#define QUANT_RAND 48               // Zellen absorbierender Rand
+
+typedef struct {
+    int nx, ny;                     // Zweierpotenzen
+    float dx, dy;                   // Pixel pro Zelle
+    float* re;
+    float* im;
+    float* maske;                   // 0 in der Wand, <1 im Randbereich
+    float* kinRe;                   // exp(-i kx² dt / 2) bzw. ky, separabel
+    float* kinIm;                   // [0, nx) für x, [nx, nx + ny) für y
+    double dt;
+    int schritt;
+
+    int width, height;
+    AppState gebaut;                // Zustand, für den das Paket gestartet wurde
+
+    Color* pixels;
+    Texture2D texture;
+    float maxDichte;
+
+    double rechenzeit;
+} Quant;
+
+static Quant quant = {0};
+static int quantGrid = 1024;        // Zellen in x, mit +/- einstellbar
+
+static void FreeQuant(Quant* q) {
+    free(q->re);
+    free(q->im);
+    free(q->maske);
+    free(q->kinRe);
+    free(q->kinIm);
+    free(q->pixels);
+    if (q->texture.id != 0) UnloadTexture(q->texture);
+    memset(q, 0, sizeof(*q));
+}
+
+static float QuantRandDaempfung(int i, int n) {
+    int abstand = i < n - 1 - i ? i : n - 1 - i;
+    if (abstand >= QUANT_RAND) return 1.0f;
+    float t = (float)(QUANT_RAND - abstand) / QUANT_RAND;
+    return 1.0f - t * t * 0.08f;
+}
+
+static void StartQuant(Quant* q, AppState* state) {
+    Spalt s = SpaltGeometrie(q->width, q->height, state);
+    double phi = (state->winkel - 90) * PI / 180.0;
+    double k0 = 2.0 * PI / state->lambda;
+    double richtX = cos(phi), richtY = -sin(phi);
+
+    // Paket startet auf halbem Weg zur Wand, ist breit genug für beide Spalte
+    // und reicht zu Beginn noch nicht bis an die Wand.
+    double abstand = 0.5 * s.xSpalt;
+    double sigma = fmax(2.0 * state->lambda, 0.6 * (state->gitterD + 2 * s.loch));
+    sigma = fmin(sigma, abstand / 3.5);
+    double x0 = s.xSpalt - abstand * richtX;
+    double y0 = q->height / 2.0 - abstand * richtY;
+
+    for (int y = 0; y < q->ny; y++) {
+        double py = (y + 0.5) * q->dy - y0;
+        for (int x = 0; x < q->nx; x++) {
+            double px = (x + 0.5) * q->dx - x0;
+            double huelle = exp(-(px * px + py * py) / (4.0 * sigma * sigma));
+            double phase = k0 * (px * richtX + py * richtY);
+            size_t i = (size_t)y * q->nx + x;
+            q->re[i] = (float)(huelle * cos(phase)) * q->maske[i];
+            q->im[i] = (float)(huelle * sin(phase)) * q->maske[i];
+        }
+    }
+
+    // Zeitschritt so, dass das Paket (Gruppengeschwindigkeit k0) pro Schritt
+    // QUANT_PX_PER_STEP Pixel weit kommt.
+    q->dt = QUANT_PX_PER_STEP / k0;
+    double normierung = 1.0 / ((double)q->nx * q->ny);
+    for (int x = 0; x < q->nx; x++) {
+        int m = x < q->nx / 2 ? x : x - q->nx;
+        double kx = 2.0 * PI * m / (q->nx * q->dx);
+        double w = -0.5 * kx * kx * q->dt;
+        q->kinRe[x] = (float)(cos(w) * normierung);
+        q->kinIm[x] = (float)(sin(w) * normierung);
+    }
+    for (int y = 0; y < q->ny; y++) {
+        int m = y < q->ny / 2 ? y : y - q->ny;
+        double ky = 2.0 * PI * m / (q->ny * q->dy);
+        double w = -0.5 * ky * ky * q->dt;
+        q->kinRe[q->nx + y] = (float)cos(w);
+        q->kinIm[q->nx + y] = (float)sin(w);
+    }
+
+    q->schritt = 0;
+    q->maxDichte = 0.0f;
+    q->gebaut = *state;
+}
+
+static void PrepareQuant(Quant* q, int width, int height, AppState* state) {
+    // Mindestens drei Zellen pro Wellenlänge, sonst faltet sich k0 zurück.
+    int nx = quantGrid;
+    while (nx < QUANT_GRID_MAX && (float)width / nx > state->lambda / 3.0f) nx *= 2;
+
+    bool neu = q->width != width || q->height != height || q->nx != nx;
+
+    if (neu) {
+        FreeQuant(q);
+        q->nx = nx;
+        q->dx = (float)width / q->nx;
+        q->ny = 1;
+        while (q->ny * 2 * q->dx < 1.41f * height && q->ny < q->nx) q->ny *= 2;
+        q->dy = (float)height / q->ny;
+        q->width = width;
+        q->height = height;
+
+        size_t n = (size_t)q->nx * q->ny;
+        q->re = malloc(n * sizeof(float));
+        q->im = malloc(n * sizeof(float));
+        q->maske = malloc(n * sizeof(float));
+        q->kinRe = malloc((q->nx + q->ny) * sizeof(float));
+        q->kinIm = malloc((q->nx + q->ny) * sizeof(float));
+        q->pixels = malloc(n * sizeof(Color));
+
+        Image image = GenImageColor(q->nx, q->ny, BLANK);
+        q->texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+
+    if (neu || q->gebaut.gitterD != state->gitterD) {
+        Spalt s = SpaltGeometrie(width, height, state);
+        for (int y = 0; y < q->ny; y++) {
+            float dy = QuantRandDaempfung(y, q->ny);
+            for (int x = 0; x < q->nx; x++) {
+                // Grobe Gitter dürfen die 5 Pixel dünne Wand nicht verfehlen.
+                float px = (x + 0.5f) * q->dx;
+                if (fabsf(px - s.xSpalt) < 0.5f * q->dx) px = (float)s.xSpalt;
+                bool wand = IstWand(s, px, (y + 0.5f) * q->dy);
+                q->maske[(size_t)y * q->nx + x] = wand ? 0.0f : dy * QuantRandDaempfung(x, q->nx);
+            }
+        }
+    }
+
+    if (neu || q->gebaut.lambda != state->lambda || q->gebaut.winkel != state->winkel ||
+        q->gebaut.gitterD != state->gitterD) {
+        StartQuant(q, state);
+    }
+}
+
+static void QuantMaske(void* ctx, int begin, int end) {
+    Quant* q = (Quant*)ctx;
+    size_t a = (size_t)begin * q->nx, b = (size_t)end * q->nx;
+    float* restrict re = q->re;
+    float* restrict im = q->im;
+    const float* restrict m = q->maske;
+
+    for (size_t i = a; i < b; i++) {
+        re[i] *= m[i];
+        im[i] *= m[i];
+    }
+}
+
+static void QuantKinetik(void* ctx, int begin, int end) {
+    Quant* q = (Quant*)ctx;
+    const float* restrict kxRe = q->kinRe;
+    const float* restrict kxIm = q->kinIm;
+
+    for (int y = begin; y < end; y++) {
+        float kyRe = q->kinRe[q->nx + y];
+        float kyIm = q->kinIm[q->nx + y];
+        float* restrict re = q->re + (size_t)y * q->nx;
+        float* restrict im = q->im + (size_t)y * q->nx;
+
+        for (int x = 0; x < q->nx; x++) {
+            float wr = kxRe[x] * kyRe - kxIm[x] * kyIm;
+            float wi = kxRe[x] * kyIm + kxIm[x] * kyRe;
+            float r = re[x], i = im[x];
+            re[x] = r * wr - i * wi;
+            im[x] = r * wi + i * wr;
+        }
+    }
+}
+
+static void StepQuant(Quant* q) {
+    ParallelFor(q->ny, 16, QuantMaske, q);
+    Fft2d(q->re, q->im, q->nx, q->ny, false);
+    ParallelFor(q->ny, 16, QuantKinetik, q);
+    Fft2d(q->re, q->im, q->nx, q->ny, true);
+    ParallelFor(q->ny, 16, QuantMaske, q);
+    q->schritt++;
+}
+
+static void QuantPixels(void* ctx, int begin, int end) {
+    Quant* q = (Quant*)ctx;
+    float skala = q->maxDichte > 0.0f ? 1.0f / q->maxDichte : 1.0f;
+
+    for (int y = begin; y < end; y++) {
+        for (int x = 0; x < q->nx; x++) {
+            size_t i = (size_t)y * q->nx + x;
+            float dichte = (q->re[i] * q->re[i] + q->im[i] * q->im[i]) * skala;
+            float v = sqrtf(dichte > 1.0f ? 1.0f : dichte);
+            unsigned char hell = (unsigned char)(255.0f * (1.0f - v));
+            q->pixels[i] = q->maske[i] == 0.0f ? BLACK : (Color){hell, hell, 255, 255};
+        }
+    }
+}
+
+void DrawSchroedinger(int width, int height, AppState* state) {
+    Quant* q = &quant;
+
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        if (quantGrid < QUANT_GRID_MAX) quantGrid *= 2;
+    }
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        if (quantGrid > QUANT_GRID_MIN) quantGrid /= 2;
+    }
+
+    PrepareQuant(q, width, height, state);
+    if (IsKeyPressed(KEY_R) || q->schritt * QUANT_PX_PER_STEP > 1.5 * width) StartQuant(q, state);
+
+    double start = NowSeconds();
+    for (int i = 0; i < QUANT_STEPS_PER_FRAME; i++) StepQuant(q);
+    double dauer = (NowSeconds() - start) / QUANT_STEPS_PER_FRAME;
+    q->rechenzeit = q->rechenzeit == 0.0 ? dauer : 0.9 * q->rechenzeit + 0.1 * dauer;
+
+    // Normierung auf das Maximum hinter der Wand, sonst verschwindet das
+    // Interferenzmuster neben dem ungebeugten Paket.
+    Spalt s = SpaltGeometrie(width, height, state);
+    int xRechts = (int)((s.xSpalt + 3) / q->dx) + 1;
+    float maxDichte = 0.0f;
+    for (int y = 0; y < q->ny; y += 2) {
+        for (int x = xRechts; x < q->nx; x += 2) {
+            size_t i = (size_t)y * q->nx + x;
+            float d = q->re[i] * q->re[i] + q->im[i] * q->im[i];
+            if (d > maxDichte) maxDichte = d;
+        }
+    }
+    q->maxDichte = maxDichte > q->maxDichte * 0.98f ? maxDichte : q->maxDichte * 0.98f;
+
+    ParallelFor(q->ny, 16, QuantPixels, q);
+    UpdateTexture(q->texture, q->pixels);
+
+    Rectangle source = {0, 0, (float)q->nx, (float)q->ny};
+    Rectangle dest = {0, 0, q->nx * q->dx, q->ny * q->dy};
+    DrawTexturePro(q->texture, source, dest, (Vector2){0, 0}, 0.0f, WHITE);
+
+    overlay_text(TextFormat("Split-Step %dx%d [+/-], R: Neustart: %.1f ms/Schritt",
+                            q->nx, q->ny, q->rechenzeit * 1000.0));
+}
+
+void UnloadSchroedinger(void) {
+    FreeQuant(&quant);
+    FreeFftPlans();
+}
@@ -0,0 +1,476 @@
+// Simulation.c
+// Eigener Simulationsthread für die Modi, deren Rechnung sonst die Darstellung
+// aufhält: Geometrie (Interferenzpunkte samt Gitter der Sonde und die Radien
+// der Wellenberge), Weißlicht (Pixel des Feldes) und Bohmsche Bahnen. Der
+// Render-Thread legt pro Frame einen AppState-Schnappschuss ab, wenn sich
+// etwas geändert hat; der Simulationsthread rechnet immer den neuesten und
+// überspringt ältere.
+//
+// Ergebnisse sind unveränderliche Objekte mit Referenzzähler. Sie laufen über
+// einen Dreifachpuffer ohne Sperren: der Simulationsthread legt das Ergebnis
+// in seinen Slot und tauscht ihn atomar gegen den mittleren, der
+// Render-Thread tauscht seinen Slot gegen den mittleren, wenn dort ein neues
+// Ergebnis liegt. Keiner wartet auf den anderen, gezeichnet wird immer das
+// letzte fertige Ergebnis. Die Latenz in Frames zwischen Schnappschuss und
+// erster Anzeige steht im Overlay. Referenzen zählt nur der
+// Simulationsthread: ein Slot kommt erst zu ihm zurück, wenn der
+// Render-Thread ihn nicht mehr liest.
+//
+// Jeder Schnappschuss bekommt eine Generation. Ein neuer Schnappschuss
+// überholt den laufenden Auftrag: über die AbbruchMarke aus Threads.c
+// brechen ParallelFor und die Kerne an ihren Prüfpunkten ab, das halbe
+// Ergebnis wird verworfen. Gezählt werden die abgebrochenen Aufträge und die
+// gesparte Zeit, hochgerechnet aus der bisherigen Dauer und dem Anteil der
+// noch offenen Stücke.
+//
+// Fertige Ergebnisse bleiben in einem LRU-Cache mit Speicherbudget
+// (DOPPELSPALT_CACHE_MB, Vorgabe SIM_CACHE_MB), ein Treffer wird ohne
+// Rechnung veröffentlicht. Da main() die Reglerwerte auf ganze Zahlen
+// abschneidet, kehren beim Hin- und Herziehen dieselben Zustände oft wieder.
+// Aus dem Tempo des gezogenen Reglers (slider_velocity) rechnet der
+// Simulationsthread im Leerlauf die nächsten ganzzahligen Zustände in
+// Zugrichtung voraus und legt sie in den Cache.
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_SLOTS 3
+#define SIM_NEU 4                   // Bit in mitte: Slot noch nicht gelesen
+#define SIM_CACHE 64                // Ergebnisse im LRU-Cache, höchstens
+#define SIM_CACHE_MB 128            // Speicherbudget des Caches
+#define SIM_FREI 2                  // verworfene Ergebnisse zur Wiederverwendung
+#define SIM_VORAUS 6                // höchstens so viele Zustände voraus
+#define SIM_VORAUS_FRAMES 4.0f      // so viele Frames der Bewegung voraus
+
+typedef enum {
+    SIM_KEINE = 0,
+    SIM_GEOMETRIE,
+    SIM_WEISSLICHT,
+    SIM_BOHM,
+} SimArt;
+
+typedef struct {
+    SimArt art;
+    AppState state;
+    int width, height;
+    float regler;                   // Weißlicht: Probenzahl, Bohm: Bahnen
+    long bild;                      // Frame, in dem der Schnappschuss entstand
+    long generation;
+    float tempo[3];                 // lambda, gitterD, winkel je Frame
+} SimAuftrag;
+
+typedef struct {
+    SimAuftrag auftrag;
+    int referenzen;                 // Slots und Cache, nur im Simulationsthread
+    bool spekulativ;                // vorausgerechnet und noch nicht abgefragt
+    long benutzt;                   // LRU-Uhr
+
+    Interferenzpunkte punkte;       // SIM_GEOMETRIE
+    int* radien[2];                 // Wellenberge um Spalt 1 und 2
+    int radienAnzahl[2], radienKapazitaet[2];
+    Vector2* wellenfront;           // ebene Welle, je zwei Punkte pro Strecke
+    int wellenfrontAnzahl, wellenfrontKapazitaet;
+
+    Color* pixels;                  // SIM_WEISSLICHT, breite x hoehe ab x0
+    int x0, breite, hoehe, proben;
+    size_t pixelKapazitaet;
+
+    Bohm bohm;                      // SIM_BOHM
+
+    double rechenzeit;
+    size_t bytes;                   // belegter Speicher, für das Cachebudget
+} SimErgebnis;
+
+typedef struct {
+    SimErgebnis* ergebnis;
+    long bild;                      // Frame der Anfrage, auch bei Cachetreffern
+} SimSlot;
+
+typedef struct {
+    SimSlot slots[SIM_SLOTS];
+    atomic_int mitte;               // Slotindex, dazu SIM_NEU
+    int schreiben;                  // nur Simulationsthread
+    int lesen;                      // nur Render-Thread
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    SimAuftrag auftrag;             // neuester Schnappschuss, unter mutex
+    long generation, erledigt;
+    bool laeuft;
+    atomic_long neueste;            // generation, ohne Sperre lesbar
+
+    atomic_long abgebrochen;
+    atomic_llong gespartNs;
+    atomic_long treffer, fehlschlaege, verdraengt;
+    atomic_llong cacheBytes;
+    atomic_long vorausGerechnet, vorausGenutzt;
+
+    // Nur im Simulationsthread
+    FeldGeometrie geometrie;
+    Weisslicht weisslicht;
+    SimErgebnis* cache[SIM_CACHE];
+    size_t cacheBudget;
+    long uhr;
+    SimErgebnis* frei[SIM_FREI];
+    int freiAnzahl;
+    SimAuftrag voraus[SIM_VORAUS];  // vorausAnzahl unter mutex
+    int vorausAnzahl;
+
+    // Nur im Render-Thread
+    long bild;
+    SimAuftrag abgelegt;
+    FeldBild textur;
+    SimAuftrag hochgeladen;         // Adressen werden wiederverwendet
+    int latenz;
+    float latenzMittel;
+} Simulation;
+
+static Simulation simulation = {0};
+static SimErgebnis simLeer = {0};   // bis zum ersten Ergebnis
+
+static bool SimGleich(const SimAuftrag* a, const SimAuftrag* b) {
+    return a->art == b->art && a->width == b->width && a->height == b->height && a->regler == b->regler &&
+           a->state.lambda == b->state.lambda && a->state.gitterD == b->state.gitterD &&
+           a->state.winkel == b->state.winkel;
+}
+
+static SimErgebnis* SimNeu(Simulation* sim) {
+    SimErgebnis* e = sim->freiAnzahl > 0 ? sim->frei[--sim->freiAnzahl] : calloc(1, sizeof(SimErgebnis));
+    e->referenzen = 1;
+    e->spekulativ = false;
+    return e;
+}
+
+static void SimLoeschen(SimErgebnis* e) {
+    FreeInterferenzpunkte(&e->punkte);
+    free(e->radien[0]);
+    free(e->radien[1]);
+    free(e->wellenfront);
+    free(e->pixels);
+    FreeBohm(&e->bohm);
+    free(e);
+}
+
+static void SimFreigeben(Simulation* sim, SimErgebnis* e) {
+    if (e == NULL || --e->referenzen > 0) return;
+    if (sim->freiAnzahl < SIM_FREI) sim->frei[sim->freiAnzahl++] = e;
+    else SimLoeschen(e);
+}
+
+static SimErgebnis* SimCacheSuchen(Simulation* sim, const SimAuftrag* a) {
+    for (int i = 0; i < SIM_CACHE; i++) {
+        if (sim->cache[i] && SimGleich(&sim->cache[i]->auftrag, a)) return sim->cache[i];
+    }
+    return NULL;
+}
+
+// Gezählt werden die Puffer nach Kapazität, wiederverwendete Ergebnisse
+// bringen ihre alten Puffer mit.
+static size_t SimGroesse(const SimErgebnis* e) {
+    const Interferenzpunkte* ip = &e->punkte;
+    return sizeof(SimErgebnis) + (size_t)ip->kapazitaet * sizeof(InterferenzPunkt) +
+           ((size_t)ip->zeilenKapazitaet + ip->zellKapazitaet + ip->punktKapazitaet) * sizeof(int) +
+           ((size_t)e->radienKapazitaet[0] + e->radienKapazitaet[1]) * sizeof(int) +
+           (size_t)e->wellenfrontKapazitaet * 2 * sizeof(Vector2) + e->pixelKapazitaet * sizeof(Color) +
+           (size_t)e->bohm.kapazitaet * BOHM_POINTS * sizeof(Vector2);
+}
+
+static void SimCacheVerdraengen(Simulation* sim, int i) {
+    atomic_fetch_sub(&sim->cacheBytes, (long long)sim->cache[i]->bytes);
+    SimFreigeben(sim, sim->cache[i]);
+    sim->cache[i] = NULL;
+}
+
+// Verdrängt die am längsten nicht benutzten Einträge, bis ein Platz frei ist
+// und e ins Budget passt. Größer als das ganze Budget: gar nicht ablegen.
+static void SimCacheAblegen(Simulation* sim, SimErgebnis* e) {
+    e->bytes = SimGroesse(e);
+    if (e->bytes > sim->cacheBudget) return;
+
+    for (;;) {
+        int frei = -1, alt = -1;
+        for (int i = 0; i < SIM_CACHE; i++) {
+            if (sim->cache[i] == NULL) {
+                if (frei < 0) frei = i;
+            } else if (alt < 0 || sim->cache[i]->benutzt < sim->cache[alt]->benutzt) {
+                alt = i;
+            }
+        }
+        if (frei >= 0 && atomic_load(&sim->cacheBytes) + e->bytes <= sim->cacheBudget) {
+            sim->cache[frei] = e;
+            break;
+        }
+        SimCacheVerdraengen(sim, alt);
+        atomic_fetch_add(&sim->verdraengt, 1);
+    }
+    atomic_fetch_add(&sim->cacheBytes, (long long)e->bytes);
+    e->referenzen++;
+    e->benutzt = ++sim->uhr;
+}
+
+static void SimVeroeffentlichen(Simulation* sim, SimErgebnis* e, long bild) {
+    SimSlot* slot = &sim->slots[sim->schreiben];
+    SimFreigeben(sim, slot->ergebnis);
+    e->referenzen++;
+    slot->ergebnis = e;
+    slot->bild = bild;
+    sim->schreiben = atomic_exchange(&sim->mitte, sim->schreiben | SIM_NEU) & ~SIM_NEU;
+}
+
+static void SimRadien(SimErgebnis* e, int j, int y, int reichweite, AppState* state) {
+    int n = KugelwelleRadien(y, reichweite, e->auftrag.height, state, NULL);
+    if (n > e->radienKapazitaet[j]) {
+        e->radienKapazitaet[j] = n;
+        e->radien[j] = realloc(e->radien[j], n * sizeof(int));
+    }
+    e->radienAnzahl[j] = KugelwelleRadien(y, reichweite, e->auftrag.height, state, e->radien[j]);
+}
+
+// false, wenn der Auftrag unterwegs überholt wurde.
+static bool SimRechnen(Simulation* sim, SimErgebnis* e, const SimAuftrag* a, AbbruchMarke* marke) {
+    double start = NowSeconds();
+    e->auftrag = *a;
+    AppState* state = &e->auftrag.state;
+
+    switch (a->art) {
+    case SIM_GEOMETRIE: {
+        if (!InterferenzpunkteAusAtlas(&atlas, &e->punkte, a->width, a->height, state)) {
+            InterferenzpunkteAktualisieren(&e->punkte, a->width, a->height, state);
+        }
+        Spalt s = SpaltGeometrie(a->width, a->height, state);
+        int reichweite = KugelwelleReichweite(a->width, a->height);
+        SimRadien(e, 0, s.ySpalt1, reichweite, state);
+        SimRadien(e, 1, s.ySpalt2, reichweite, state);
+        int n = EbeneWelleStrecken(s.xSpalt, a->height, state->lambda, state->winkel, NULL);
+        if (n > e->wellenfrontKapazitaet) {
+            e->wellenfrontKapazitaet = n;
+            e->wellenfront = realloc(e->wellenfront, n * 2 * sizeof(Vector2));
+        }
+        e->wellenfrontAnzahl = EbeneWelleStrecken(s.xSpalt, a->height, state->lambda, state->winkel, e->wellenfront);
+        break;
+    }
+    case SIM_WEISSLICHT: {
+        FeldGeometrie* g = FeldGeometrieAktualisieren(&sim->geometrie, a->width, a->height, state);
+        size_t n = (size_t)g->breite * g->hoehe;
+        if (n > e->pixelKapazitaet) {
+            e->pixelKapazitaet = n;
+            e->pixels = realloc(e->pixels, n * sizeof(Color));
+        }
+        e->x0 = g->x0;
+        e->breite = g->breite;
+        e->hoehe = g->hoehe;
+        WeisslichtRechnen(&sim->weisslicht, g, e->pixels, state, (int)a->regler);
+        e->proben = sim->weisslicht.proben;
+        break;
+    }
+    case SIM_BOHM:
+        ComputeBohm(&e->bohm, a->width, a->height, state, (int)a->regler);
+        break;
+    case SIM_KEINE:
+        break;
+    }
+    e->rechenzeit = NowSeconds() - start;
+
+    if (Abgebrochen()) {
+        // Halb gefüllte Zwischenstände dürfen nicht als gültig gelten.
+        e->punkte.width = 0;
+        sim->geometrie.gitterD = -1;
+        long gesamt = atomic_load(&marke->gesamt), fertig = atomic_load(&marke->fertig);
+        if (fertig > 0 && gesamt > fertig) {
+            atomic_fetch_add(&sim->gespartNs, (long long)(e->rechenzeit * (gesamt - fertig) / fertig * 1e9));
+        }
+        atomic_fetch_add(&sim->abgebrochen, 1);
+        return false;
+    }
+    return true;
+}
+
+static int* SimWert(AppState* state, int feld) {
+    return feld == 0 ? &state->lambda : feld == 1 ? &state->gitterD : &state->winkel;
+}
+
+// Zustände in Zugrichtung des am schnellsten bewegten Reglers: so viele, wie
+// in SIM_VORAUS_FRAMES Frames überstrichen werden, und bei mehr als einer
+// Einheit je Frame im Abstand des Tempos, weil main() dazwischen nichts zeigt.
+// Bohm bleibt außen vor, die Bahnen sind zu groß für den Cache.
+static int SimVorausPlanen(const SimAuftrag* a, SimAuftrag* voraus) {
+    static const int grenzen[3][2] = {{10, 85}, {0, 150}, {0, 180}};
+    if (a->art != SIM_GEOMETRIE && a->art != SIM_WEISSLICHT) return 0;
+
+    int feld = 0;
+    for (int i = 1; i < 3; i++) {
+        if (fabsf(a->tempo[i]) > fabsf(a->tempo[feld])) feld = i;
+    }
+    float tempo = a->tempo[feld];
+    if (fabsf(tempo) < 0.05f) return 0;
+
+    int anzahl = (int)ceilf(fabsf(tempo) * SIM_VORAUS_FRAMES);
+    if (anzahl > SIM_VORAUS) anzahl = SIM_VORAUS;
+    float abstand = fabsf(tempo) > 1.0f ? fabsf(tempo) : 1.0f;
+
+    int n = 0;
+    for (int k = 1; k <= anzahl; k++) {
+        SimAuftrag v = *a;
+        int* wert = SimWert(&v.state, feld);
+        int schritt = (int)lroundf(k * abstand);
+        *wert += tempo > 0.0f ? schritt : -schritt;
+        if (*wert < grenzen[feld][0] || *wert > grenzen[feld][1]) break;
+        voraus[n++] = v;
+    }
+    return n;
+}
+
+static void* SimMain(void* arg) {
+    Simulation* sim = (Simulation*)arg;
+    ThreadAnmelden();
+
+    pthread_mutex_lock(&sim->mutex);
+    for (;;) {
+        while (sim->laeuft && sim->erledigt == sim->generation && sim->vorausAnzahl == 0) {
+            pthread_cond_wait(&sim->wake, &sim->mutex);
+        }
+        if (!sim->laeuft) break;
+        long generation = sim->generation;
+        bool echt = sim->erledigt != generation;
+        SimAuftrag auftrag = echt ? sim->auftrag : sim->voraus[--sim->vorausAnzahl];
+        pthread_mutex_unlock(&sim->mutex);
+
+        AbbruchMarke marke = {&sim->neueste, generation, 0, 0};
+        AbbruchSetzen(&marke);
+        SimErgebnis* e = SimCacheSuchen(sim, &auftrag);
+        SimAuftrag voraus[SIM_VORAUS];
+        int vorausAnzahl = 0;
+
+        if (echt) {
+            if (e) {
+                atomic_fetch_add(&sim->treffer, 1);
+                if (e->spekulativ) atomic_fetch_add(&sim->vorausGenutzt, 1);
+                e->spekulativ = false;
+                e->benutzt = ++sim->uhr;
+                SimVeroeffentlichen(sim, e, auftrag.bild);
+            } else {
+                atomic_fetch_add(&sim->fehlschlaege, 1);
+                e = SimNeu(sim);
+                if (SimRechnen(sim, e, &auftrag, &marke)) {
+                    SimCacheAblegen(sim, e);
+                    SimVeroeffentlichen(sim, e, auftrag.bild);
+                }
+                SimFreigeben(sim, e);
+            }
+            vorausAnzahl = SimVorausPlanen(&auftrag, voraus);
+        } else if (e == NULL) {
+            e = SimNeu(sim);
+            if (SimRechnen(sim, e, &auftrag, &marke)) {
+                e->spekulativ = true;
+                SimCacheAblegen(sim, e);
+                atomic_fetch_add(&sim->vorausGerechnet, 1);
+            }
+            SimFreigeben(sim, e);
+        }
+        AbbruchSetzen(NULL);
+
+        pthread_mutex_lock(&sim->mutex);
+        if (echt) {
+            sim->erledigt = generation;
+            // Vom Stapel wird hinten genommen, der nächste Zustand also zuletzt abgelegt.
+            sim->vorausAnzahl = vorausAnzahl;
+            for (int i = 0; i < vorausAnzahl; i++) sim->voraus[i] = voraus[vorausAnzahl - 1 - i];
+        }
+        if (sim->erledigt != sim->generation) sim->vorausAnzahl = 0;
+    }
+    pthread_mutex_unlock(&sim->mutex);
+    return NULL;
+}
+
+static void StartSimulation(void) {
+    Simulation* sim = &simulation;
+    InitSrgbTabelle();
+    const char* mb = getenv("DOPPELSPALT_CACHE_MB");
+    sim->cacheBudget = (size_t)(mb ? atoi(mb) : SIM_CACHE_MB) << 20;
+    sim->schreiben = 0;
+    atomic_store(&sim->mitte, 1);
+    sim->lesen = 2;
+    sim->laeuft = true;
+    pthread_mutex_init(&sim->mutex, NULL);
+    pthread_cond_init(&sim->wake, NULL);
+    pthread_create(&sim->thread, NULL, SimMain, sim);
+}
+
+// Einmal pro Frame: legt bei Änderung einen neuen Schnappschuss ab und holt
+// das neueste fertige Ergebnis. Blockiert nie auf die Rechnung. tempo ist
+// die Reglerbewegung von lambda, gitterD und winkel je Frame.
+static SimErgebnis* SimAktualisieren(SimArt art, AppState* state, int width, int height, float regler,
+                                     const float tempo[3]) {
+    Simulation* sim = &simulation;
+    sim->bild++;
+
+    SimAuftrag auftrag = {art, *state, width, height, art == SIM_GEOMETRIE ? 0.0f : regler, sim->bild, 0,
+                          {tempo[0], tempo[1], tempo[2]}};
+    if (art != SIM_KEINE && !SimGleich(&auftrag, &sim->abgelegt)) {
+        pthread_mutex_lock(&sim->mutex);
+        auftrag.generation = ++sim->generation;
+        sim->auftrag = auftrag;
+        atomic_store(&sim->neueste, auftrag.generation);
+        pthread_cond_signal(&sim->wake);
+        pthread_mutex_unlock(&sim->mutex);
+        sim->abgelegt = auftrag;
+    }
+
+    if (atomic_load(&sim->mitte) & SIM_NEU) {
+        sim->lesen = atomic_exchange(&sim->mitte, sim->lesen) & ~SIM_NEU;
+        sim->latenz = (int)(sim->bild - sim->slots[sim->lesen].bild);
+        sim->latenzMittel += 0.1f * (sim->latenz - sim->latenzMittel);
+    }
+
+    SimErgebnis* e = sim->slots[sim->lesen].ergebnis;
+    if (e == NULL) e = &simLeer;
+    if (e->auftrag.art == SIM_WEISSLICHT && !SimGleich(&e->auftrag, &sim->hochgeladen)) {
+        PrepareFeldBild(&sim->textur, e->x0, e->breite, e->hoehe);
+        UpdateTexture(sim->textur.texture, e->pixels);
+        sim->hochgeladen = e->auftrag;
+    }
+
+    if (art != SIM_KEINE) {
+        long treffer = atomic_load(&sim->treffer), anfragen = treffer + atomic_load(&sim->fehlschlaege);
+        overlay_text(TextFormat("Simulation: Latenz %d Frames (Mittel %.1f), Rechenzeit %.1f ms", sim->latenz,
+                                sim->latenzMittel, e->rechenzeit * 1000.0));
+        overlay_text(TextFormat("Überholt und abgebrochen: %ld Aufträge, etwa %.0f ms gespart",
+                                atomic_load(&sim->abgebrochen), atomic_load(&sim->gespartNs) * 1e-6));
+        overlay_text(TextFormat("Cache: %.0f%% Treffer (%ld/%ld), %ld verdrängt, %.1f von %zu MB",
+                                anfragen ? 100.0 * treffer / anfragen : 0.0, treffer, anfragen,
+                                atomic_load(&sim->verdraengt), atomic_load(&sim->cacheBytes) / 1048576.0,
+                                sim->cacheBudget >> 20));
+        if (atlas.kopf) {
+            overlay_text(TextFormat("Atlas: %ld Punktsätze gelesen, %.0f MB abgebildet", atomic_load(&atlas.gelesen),
+                                    atlas.groesse / 1048576.0));
+        }
+        overlay_text(TextFormat("Vorausgerechnet: %ld Zustände, davon genutzt %ld", atomic_load(&sim->vorausGerechnet),
+                                atomic_load(&sim->vorausGenutzt)));
+    }
+    return e;
+}
+
+static void DrawSimWeisslicht(SimErgebnis* e) {
+    if (e->auftrag.art != SIM_WEISSLICHT) return;
+    DrawFeldBild(&simulation.textur);
+    overlay_text(TextFormat("Weißlicht: %d Wellenlängen, %.1f ms", e->proben, e->rechenzeit * 1000.0));
+}
+
+static void StopSimulation(void) {
+    Simulation* sim = &simulation;
+    pthread_mutex_lock(&sim->mutex);
+    sim->laeuft = false;
+    pthread_cond_signal(&sim->wake);
+    pthread_mutex_unlock(&sim->mutex);
+    pthread_join(sim->thread, NULL);
+
+    for (int i = 0; i < SIM_SLOTS; i++) SimFreigeben(sim, sim->slots[i].ergebnis);
+    for (int i = 0; i < SIM_CACHE; i++) SimFreigeben(sim, sim->cache[i]);
+    for (int i = 0; i < sim->freiAnzahl; i++) SimLoeschen(sim->frei[i]);
+    FeldGeometrieFreigeben(&sim->geometrie);
+    FreeFeldBild(&sim->textur);
+    memset(sim, 0, sizeof(*sim));
+}
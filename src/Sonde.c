@@ -0,0 +1,344 @@
+// Sonde.c
+// Mauszeiger-Sonde für den Geometrie-Modus: r1, r2, Gangunterschied in
+// Wellenlängen und Intensität am Zeiger, dazu der nächste Interferenzpunkt
+// mit seinen Ringindizes (i1, i2).
+//
+// Die Punkte aus DrawInterferencePoints liegen als Feld vor und werden im
+// Simulationsthread nur bei Änderung von AppState oder Fenstergröße neu
+// gerechnet, zusammen mit einem gleichmäßigen Gitter (Zählsortierung nach
+// Zellen). Die Sonde fragt immer die gerade angezeigten Punkte ab. Der
+// nächste Punkt wird ringweise um die Zelle des Zeigers gesucht und die Suche
+// beendet, sobald kein weiterer Ring näher liegen kann. r1 und r2 kommen aus
+// FeldGeometrie, die Abfrage kostet damit nur Mikrosekunden.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    Vector2 p;
+    int i1, i2;                     // Wellenberg von Spalt 1 bzw. 2
+} InterferenzPunkt;
+
+typedef struct {
+    InterferenzPunkt* punkte;
+    int anzahl, kapazitaet;
+    int radius;                     // Radius der gezeichneten Kreise
+    int* zeilenStart;               // erster Punkt je i1, nWellen + 1 Einträge
+    int zeilenKapazitaet;
+
+    float zelle;
+    int spalten, zeilen;
+    int* zellStart;                 // spalten * zeilen + 1 Einträge
+    int* zellPunkte;                // Punktindizes nach Zelle sortiert
+    int zellKapazitaet, punktKapazitaet;
+
+    int width, height;
+    AppState gebaut;
+    double rechenzeit;
+} Interferenzpunkte;
+
+typedef struct {
+    Interferenzpunkte* ip;
+    int breite, hoehe;
+    int lambda, gitterD, nWellen;
+    double s0;
+} PunkteAuftrag;
+
+// Punkte der Zeile i1 nach aus schreiben (aus == NULL: nur zählen).
+static int PunkteZeile(const PunkteAuftrag* a, int i1, InterferenzPunkt* aus) {
+    int anzahl = 0;
+    for (int i2 = 0; i2 < a->nWellen; i2++) {
+        double tempR1 = i1 * a->lambda - a->s0;
+        double tempR2 = i2 * a->lambda + a->s0;
+
+        if (tempR1 + tempR2 > a->gitterD && tempR1 <= tempR2 + a->gitterD && tempR2 <= tempR1 + a->gitterD) {
+            if (aus) {
+                double tempY = (tempR1 * tempR1 - tempR2 * tempR2 + a->gitterD * a->gitterD) / (2.0 * a->gitterD);
+                double tempX = sqrt(tempR1 * tempR1 - tempY * tempY);
+
+                int circleX = a->breite / 3 + (int)tempX;
+                int circleY = (a->hoehe - a->gitterD) / 2 + ((int)tempY - a->ip->radius / 2) + 10;
+                aus[anzahl] = (InterferenzPunkt){{(float)circleX, (float)circleY}, i1, i2};
+            }
+            anzahl++;
+        }
+    }
+    return anzahl;
+}
+
+static void PunkteZaehlen(void* ctx, int begin, int end) {
+    PunkteAuftrag* a = (PunkteAuftrag*)ctx;
+    for (int i1 = begin; i1 < end; i1++) a->ip->zeilenStart[i1 + 1] = PunkteZeile(a, i1, NULL);
+}
+
+static void PunkteFuellen(void* ctx, int begin, int end) {
+    PunkteAuftrag* a = (PunkteAuftrag*)ctx;
+    for (int i1 = begin; i1 < end; i1++) PunkteZeile(a, i1, a->ip->punkte + a->ip->zeilenStart[i1]);
+}
+
+static int PunkteRadius(int lambda) {
+    int tempR3 = 12;
+    if (lambda <= 20) tempR3 = 9;
+    if (lambda <= 15) tempR3 = 7;
+
+    if (tempR3 < 5) tempR3 = 5;
+    return tempR3;
+}
+
+// Zweimal über die Zeilen i1 im Thread-Pool: erst zählen, dann nach der
+// Präfixsumme an festen Stellen schreiben. Die Reihenfolge der Punkte bleibt
+// dieselbe wie bei der einfachen Doppelschleife. Wird der Auftrag überholt,
+// fehlen übersprungene Zeilen in zeilenStart; dann bleibt es bei anzahl = 0
+// und false, statt aus alten Zählern Summe und Speicher zu bilden.
+static bool PunkteRechnen(Interferenzpunkte* ip, int breite, int hoehe, AppState* state) {
+    double phi = (state->winkel - 90) * M_PI / 180.0;
+    double s0 = fmod((double) state->gitterD / 2.0 * sin(phi), state->lambda);
+    int nWellen = breite / state->lambda;
+
+    ip->anzahl = 0;
+    ip->radius = PunkteRadius(state->lambda);
+    if (state->gitterD == 0) return true;
+
+    if (nWellen + 1 > ip->zeilenKapazitaet) {
+        ip->zeilenKapazitaet = nWellen + 1;
+        ip->zeilenStart = realloc(ip->zeilenStart, ip->zeilenKapazitaet * sizeof(int));
+    }
+    PunkteAuftrag a = {ip, breite, hoehe, state->lambda, state->gitterD, nWellen, s0};
+    ip->zeilenStart[0] = 0;
+    ParallelFor(nWellen, 16, PunkteZaehlen, &a);
+    if (Abgebrochen()) return false;
+    for (int i1 = 0; i1 < nWellen; i1++) ip->zeilenStart[i1 + 1] += ip->zeilenStart[i1];
+
+    ip->anzahl = ip->zeilenStart[nWellen];
+    if (ip->anzahl > ip->kapazitaet) {
+        ip->kapazitaet = ip->anzahl;
+        ip->punkte = realloc(ip->punkte, ip->kapazitaet * sizeof(InterferenzPunkt));
+    }
+    ParallelFor(nWellen, 16, PunkteFuellen, &a);
+    if (Abgebrochen()) {
+        ip->anzahl = 0;
+        return false;
+    }
+    return true;
+}
+
+static int PunktZelle(const Interferenzpunkte* ip, float x, float y, int* zx, int* zy) {
+    int cx = (int)floorf(x / ip->zelle), cy = (int)floorf(y / ip->zelle);
+    cx = cx < 0 ? 0 : (cx >= ip->spalten ? ip->spalten - 1 : cx);
+    cy = cy < 0 ? 0 : (cy >= ip->zeilen ? ip->zeilen - 1 : cy);
+    if (zx) *zx = cx;
+    if (zy) *zy = cy;
+    return cy * ip->spalten + cx;
+}
+
+// Zählsortierung der Punkte nach Zelle; Punkte außerhalb landen in Randzellen.
+// Die Zellen fassen im Mittel etwa zwei Punkte, aber mindestens lambda.
+static void GitterBauen(Interferenzpunkte* ip, int breite, int hoehe, int lambda) {
+    float mittel = sqrtf(2.0f * breite * hoehe / (ip->anzahl > 0 ? ip->anzahl : 1));
+    ip->zelle = fmaxf((float)lambda, mittel);
+    ip->spalten = (int)ceilf(breite / ip->zelle);
+    ip->zeilen = (int)ceilf(hoehe / ip->zelle);
+    int zellen = ip->spalten * ip->zeilen;
+
+    if (zellen + 1 > ip->zellKapazitaet) {
+        ip->zellKapazitaet = zellen + 1;
+        ip->zellStart = realloc(ip->zellStart, ip->zellKapazitaet * sizeof(int));
+    }
+    if (ip->anzahl > ip->punktKapazitaet) {
+        ip->punktKapazitaet = ip->anzahl;
+        ip->zellPunkte = realloc(ip->zellPunkte, ip->punktKapazitaet * sizeof(int));
+    }
+
+    memset(ip->zellStart, 0, (zellen + 1) * sizeof(int));
+    for (int i = 0; i < ip->anzahl; i++) {
+        ip->zellStart[PunktZelle(ip, ip->punkte[i].p.x, ip->punkte[i].p.y, NULL, NULL) + 1]++;
+    }
+    for (int z = 0; z < zellen; z++) ip->zellStart[z + 1] += ip->zellStart[z];
+    for (int i = 0; i < ip->anzahl; i++) {
+        int z = PunktZelle(ip, ip->punkte[i].p.x, ip->punkte[i].p.y, NULL, NULL);
+        ip->zellPunkte[ip->zellStart[z]++] = i;
+    }
+    // zellStart zeigt jetzt auf das Ende jeder Zelle, eins zurückschieben.
+    for (int z = zellen; z > 0; z--) ip->zellStart[z] = ip->zellStart[z - 1];
+    ip->zellStart[0] = 0;
+}
+
+static Interferenzpunkte* InterferenzpunkteAktualisieren(Interferenzpunkte* ip, int breite, int hoehe,
+                                                         AppState* state) {
+    if (ip->width == breite && ip->height == hoehe && ip->gebaut.lambda == state->lambda &&
+        ip->gebaut.gitterD == state->gitterD && ip->gebaut.winkel == state->winkel) {
+        return ip;
+    }
+
+    double start = NowSeconds();
+    if (!PunkteRechnen(ip, breite, hoehe, state)) {
+        // Kein Gitter über halbe Punkte; width = 0 heißt „nicht gebaut“.
+        ip->width = 0;
+        return ip;
+    }
+    GitterBauen(ip, breite, hoehe, state->lambda);
+    ip->rechenzeit = NowSeconds() - start;
+    ip->width = breite;
+    ip->height = hoehe;
+    ip->gebaut = *state;
+    return ip;
+}
+
+// Index des nächsten Punkts zu p (im Gitter) oder -1, wenn es keine gibt.
+// Punkte außerhalb stecken in Randzellen und liegen damit nur weiter weg,
+// die Schranke für den Abbruch bleibt gültig.
+static int NaechsterPunkt(const Interferenzpunkte* ip, Vector2 p, float* abstand) {
+    int cx, cy;
+    PunktZelle(ip, p.x, p.y, &cx, &cy);
+    int wahl = -1;
+    float best2 = INFINITY;
+    int maxRing = ip->spalten > ip->zeilen ? ip->spalten : ip->zeilen;
+
+    for (int ring = 0; ring <= maxRing; ring++) {
+        for (int y = cy - ring; y <= cy + ring; y++) {
+            if (y < 0 || y >= ip->zeilen) continue;
+            bool randZeile = y == cy - ring || y == cy + ring;
+            for (int x = cx - ring; x <= cx + ring; x += randZeile ? 1 : 2 * ring) {
+                if (x >= 0 && x < ip->spalten) {
+                    int z = y * ip->spalten + x;
+                    for (int k = ip->zellStart[z]; k < ip->zellStart[z + 1]; k++) {
+                        int i = ip->zellPunkte[k];
+                        float d2 = Vector2DistanceSqr(p, ip->punkte[i].p);
+                        if (d2 < best2) {
+                            best2 = d2;
+                            wahl = i;
+                        }
+                    }
+                }
+                if (ring == 0) break;
+            }
+        }
+        // Alle Zellen im Ring ring + 1 liegen mindestens ring Zellen entfernt.
+        float schranke = ring * ip->zelle;
+        if (wahl >= 0 && best2 <= schranke * schranke) break;
+    }
+    if (abstand) *abstand = sqrtf(best2);
+    return wahl;
+}
+
+// state ist der Stand, zu dem ip gerechnet wurde.
+void DrawSonde(const Interferenzpunkte* ip, int width, int height, AppState* state) {
+    if (active_id >= 0) return;
+    Vector2 maus = GetMousePosition();
+    if (maus.x < 0 || maus.y < 0 || maus.x >= width || maus.y >= height - PANEL_HOEHE) return;
+
+    FeldGeometrie* g = GetFeldGeometrie(width, height, state);
+    double start = NowSeconds();
+
+    int px = (int)maus.x - g->x0, py = (int)maus.y;
+    bool rechts = px >= 0 && px < g->breite && py < g->hoehe;
+    float r1 = 0.0f, r2 = 0.0f, delta = 0.0f, intensitaet = 0.0f;
+    if (rechts) {
+        r1 = g->r1[(size_t)py * g->breite + px];
+        r2 = g->r2[(size_t)py * g->breite + px];
+        double phi = (state->winkel - 90) * PI / 180.0;
+        delta = (float)((r1 - r2 + state->gitterD * sin(phi)) / state->lambda);
+        float a1 = 1.0f / sqrtf(r1), a2 = 1.0f / sqrtf(r2);
+        intensitaet = (a1 * a1 + a2 * a2 + 2.0f * a1 * a2 * cosf(2.0f * PI * delta)) / ((a1 + a2) * (a1 + a2));
+    }
+
+    float abstand = 0.0f;
+    int naechster = NaechsterPunkt(ip, maus, &abstand);
+    double abfrage = NowSeconds() - start;
+
+    if (rechts) {
+        overlay_text(TextFormat("Sonde: r1 %.1f, r2 %.1f, Gangunterschied %.3f lambda, I %.3f", r1, r2, delta,
+                                intensitaet));
+    } else {
+        overlay_text("Sonde: links der Wand");
+    }
+    if (naechster >= 0) {
+        const InterferenzPunkt* q = &ip->punkte[naechster];
+        DrawCircleLinesV(q->p, ip->radius + 4.0f, DARKBLUE);
+        DrawLineV(maus, q->p, DARKBLUE);
+        overlay_text(TextFormat("Nächster Punkt (i1 %d, i2 %d) bei (%.0f, %.0f), %.1f px entfernt", q->i1, q->i2,
+                                q->p.x, q->p.y, abstand));
+    }
+    overlay_text(TextFormat("%d Punkte, Abfrage %.1f us (Neubau %.2f ms)", ip->anzahl, abfrage * 1e6,
+                            ip->rechenzeit * 1000.0));
+}
+
+static void FreeInterferenzpunkte(Interferenzpunkte* ip) {
+    free(ip->punkte);
+    free(ip->zellStart);
+    free(ip->zellPunkte);
+    free(ip->zeilenStart);
+    memset(ip, 0, sizeof(*ip));
+}
+
+// Pool gegen deterministischen Modus: PunkteRechnen muss für ein Raster von
+// Zuständen dieselben Punkte in derselben Reihenfolge liefern. Gibt die Zahl
+// der Abweichungen zurück.
+static long PunktePruefen(int breite, int hoehe) {
+    Interferenzpunkte parallel = {0}, seriell = {0};
+    long fehler = 0, zustaende = 0;
+    double start = NowSeconds();
+    for (int lambda = 10; lambda <= 85; lambda += 5) {
+        for (int gitterD = 0; gitterD <= 150; gitterD += 10) {
+            for (int winkel = 0; winkel <= 180; winkel += 15) {
+                AppState state = {.lambda = lambda, .gitterD = gitterD, .winkel = winkel};
+                PunkteRechnen(&parallel, breite, hoehe, &state);
+                ThreadsDeterministisch(true);
+                PunkteRechnen(&seriell, breite, hoehe, &state);
+                ThreadsDeterministisch(false);
+
+                bool gleich = parallel.anzahl == seriell.anzahl;
+                for (int i = 0; gleich && i < parallel.anzahl; i++) {
+                    gleich = memcmp(&parallel.punkte[i], &seriell.punkte[i], sizeof(InterferenzPunkt)) == 0;
+                }
+                if (!gleich && fehler++ < 10) {
+                    fprintf(stderr, "Punkte: Pool weicht ab bei lambda %d, gitterD %d, winkel %d\n", lambda, gitterD,
+                            winkel);
+                }
+                zustaende++;
+            }
+        }
+    }
+    printf("Punkte %dx%d, %d Threads gegen deterministisch: %ld Zustände, %ld Abweichungen, %.1f s\n", breite, hoehe,
+           ThreadCount(), zustaende, fehler, NowSeconds() - start);
+    FreeInterferenzpunkte(&parallel);
+    FreeInterferenzpunkte(&seriell);
+    return fehler;
+}
+
+// Überholter Auftrag: zeilenStart hält noch Zähler eines früheren Zustands,
+// alle Stücke fallen weg. Es darf weder Speicher nach diesen alten
+// Zählern angefordert noch ein Gitter gebaut werden, und der nächste echte
+// Auftrag muss dasselbe liefern wie ein frischer.
+static long PunkteAbbruchPruefen(int breite, int hoehe) {
+    Interferenzpunkte ip = {0}, frisch = {0};
+    AppState state = {.lambda = 10, .gitterD = 150, .winkel = 45};
+    long fehler = 0;
+
+    ip.zeilenKapazitaet = breite / state.lambda + 1;
+    ip.zeilenStart = malloc(ip.zeilenKapazitaet * sizeof(int));
+    for (int i = 0; i < ip.zeilenKapazitaet; i++) ip.zeilenStart[i] = 1000;
+    atomic_long neueste = 1;
+    AbbruchMarke marke = {&neueste, 0, 0, 0};
+    AbbruchSetzen(&marke);
+    InterferenzpunkteAktualisieren(&ip, breite, hoehe, &state);
+    AbbruchSetzen(NULL);
+    if (ip.anzahl != 0 || ip.kapazitaet != 0 || ip.zellKapazitaet != 0 || ip.width != 0) {
+        fprintf(stderr, "Punkte: abgebrochener Auftrag hinterlässt anzahl %d, kapazitaet %d, zellKapazitaet %d\n",
+                ip.anzahl, ip.kapazitaet, ip.zellKapazitaet);
+        fehler++;
+    }
+
+    InterferenzpunkteAktualisieren(&ip, breite, hoehe, &state);
+    InterferenzpunkteAktualisieren(&frisch, breite, hoehe, &state);
+    if (ip.anzahl != frisch.anzahl ||
+        memcmp(ip.punkte, frisch.punkte, frisch.anzahl * sizeof(InterferenzPunkt)) != 0) {
+        fprintf(stderr, "Punkte: nach Abbruch %d statt %d Punkte\n", ip.anzahl, frisch.anzahl);
+        fehler++;
+    }
+    printf("Punkte nach Abbruch: %s\n", fehler ? "FEHLER" : "ok");
+    FreeInterferenzpunkte(&ip);
+    FreeInterferenzpunkte(&frisch);
+    return fehler;
+}
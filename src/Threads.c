@@ -0,0 +1,332 @@
+// Threads.c
+// Thread-Pool mit Arbeitsdiebstahl für alle Rechenkerne. Jeder Worker und der
+// Render-Thread (Platz 0) haben eine eigene Deque: der Besitzer legt unten ab
+// und nimmt unten weg, die anderen stehlen oben. ParallelFor teilt seinen
+// Bereich rekursiv in Hälften, bis ein Stück höchstens grain Elemente hat,
+// und legt dabei die rechten Hälften ab. Wer auf eine Aufgabengruppe wartet,
+// arbeitet mit, bis sie leer ist; Aufträge dürfen deshalb auch aus Aufgaben
+// heraus gestartet werden.
+//
+// Die Stückgrenzen liegen immer bei begin + k * grain, unabhängig davon, wer
+// welches Stück rechnet. Im deterministischen Modus (ThreadsDeterministisch
+// oder DOPPELSPALT_DETERMINISTISCH=1) laufen dieselben Stücke nacheinander in
+// Indexreihenfolge auf dem aufrufenden Thread, für reproduzierbare Tests;
+// ./main --pruefen vergleicht damit die Punkte des Pools (PunktePruefen).
+// Jeder Thread zählt seine Rechenzeit, ThreadsAuslastung macht daraus eine
+// Zeile für das Overlay.
+//
+// Threads außerhalb des Pools (etwa der Simulationsthread) melden sich mit
+// ThreadAnmelden an und bekommen eine eigene Deque hinter den Workern.
+//
+// Abbruch: ein Thread kann mit AbbruchSetzen eine Marke (Generation eines
+// Auftrags und Zähler der neuesten Generation) setzen. ParallelFor gibt sie an
+// alle Stücke weiter; ist der Auftrag überholt, werden übrige Stücke
+// übersprungen, und lange Kerne fragen zwischendurch Abgebrochen().
+//
+// Die Schnittstelle ist wie in FastMath.c static inline: auch Feldabfrage.c
+// bindet die Datei ein, braucht aber nur einen Teil davon.
+#ifndef THREADS_C_
+#define THREADS_C_
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define THREADS_MAX 64
+#define THREADS_FREMD 2             // angemeldete Threads außerhalb des Pools
+#define DEQUE_PLAETZE 128           // Tiefe wächst nur logarithmisch mit dem Bereich
+
+typedef void (*ParallelFn)(void* ctx, int begin, int end);
+
+// Der Auftrag mit generation gilt als abgebrochen, sobald *neueste weiterzählt.
+// gesamt und fertig zählen die Stücke aller ParallelFor unter dieser Marke,
+// daraus lässt sich beim Abbruch die gesparte Zeit abschätzen.
+typedef struct {
+    const atomic_long* neueste;
+    long generation;
+    atomic_long gesamt, fertig;
+} AbbruchMarke;
+
+typedef struct {
+    atomic_int offen;               // abgelegte oder laufende Aufgaben
+    AbbruchMarke* abbruch;          // NULL: nicht abbrechbar
+} AufgabenGruppe;
+
+typedef struct {
+    ParallelFn fn;
+    void* ctx;
+    int begin, end, grain;
+    AufgabenGruppe* gruppe;
+} Aufgabe;
+
+typedef struct {
+    atomic_flag sperre;             // kurz gehalten, nur für unten/oben
+    int unten, oben;                // belegt sind [oben, unten), modulo DEQUE_PLAETZE
+    Aufgabe plaetze[DEQUE_PLAETZE];
+    atomic_llong rechenNs;          // Zeit in Aufgaben, ohne verschachtelte doppelt
+} Deque;
+
+typedef struct {
+    pthread_t threads[THREADS_MAX];
+    atomic_int count;               // Worker ohne den Render-Thread
+    Deque deques[THREADS_MAX + 1 + THREADS_FREMD]; // [0]: Render-Thread, dahinter Worker, am Ende fremde
+    atomic_int fremde;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    atomic_int wartend;             // abgelegte, noch nicht genommene Aufgaben
+    atomic_int schlafend;
+    atomic_bool running;
+    atomic_bool deterministisch;
+
+    double messStart;
+    long long messStand[THREADS_MAX + 1 + THREADS_FREMD];
+    char auslastung[128];           // eine Overlay-Zeile
+} ThreadPool;
+
+static ThreadPool pool = {0};
+static _Thread_local int threadPlatz = 0;
+static _Thread_local int threadTiefe = 0;
+static _Thread_local AbbruchMarke* threadAbbruch = NULL;
+
+static inline void AbbruchSetzen(AbbruchMarke* marke) {
+    threadAbbruch = marke;
+}
+
+// Prüfpunkt für Kerne: wurde der laufende Auftrag überholt?
+static inline bool Abgebrochen(void) {
+    const AbbruchMarke* m = threadAbbruch;
+    return m && atomic_load_explicit(m->neueste, memory_order_relaxed) != m->generation;
+}
+
+// Monotone Uhr für Messungen, auch ohne offenes Fenster nutzbar.
+static inline double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void DequeSperren(Deque* d) {
+    while (atomic_flag_test_and_set_explicit(&d->sperre, memory_order_acquire)) sched_yield();
+}
+
+static void DequeFreigeben(Deque* d) {
+    atomic_flag_clear_explicit(&d->sperre, memory_order_release);
+}
+
+static bool AufgabeAblegen(const Aufgabe* a) {
+    Deque* d = &pool.deques[threadPlatz];
+    DequeSperren(d);
+    bool platz = d->unten - d->oben < DEQUE_PLAETZE;
+    if (platz) d->plaetze[d->unten++ % DEQUE_PLAETZE] = *a;
+    DequeFreigeben(d);
+    if (!platz) return false;
+
+    atomic_fetch_add(&pool.wartend, 1);
+    if (atomic_load(&pool.schlafend) > 0) {
+        pthread_mutex_lock(&pool.mutex);
+        pthread_cond_broadcast(&pool.wake);
+        pthread_mutex_unlock(&pool.mutex);
+    }
+    return true;
+}
+
+// k-te belegte Deque: erst Render-Thread und Worker, dann die fremden.
+static int DequePlatz(int k) {
+    return k <= pool.count ? k : THREADS_MAX + 1 + (k - pool.count - 1);
+}
+
+static int DequeAnzahl(void) {
+    return pool.count + 1 + atomic_load(&pool.fremde);
+}
+
+// Eigene Deque von unten, sonst reihum die anderen von oben.
+static bool AufgabeHolen(Aufgabe* a) {
+    int plaetze = DequeAnzahl();
+    for (int i = -1; i < plaetze; i++) {
+        int opfer = i < 0 ? threadPlatz : DequePlatz(i);
+        if (i >= 0 && opfer == threadPlatz) continue;
+        Deque* d = &pool.deques[opfer];
+        DequeSperren(d);
+        bool da = d->unten > d->oben;
+        if (da) *a = i < 0 ? d->plaetze[--d->unten % DEQUE_PLAETZE] : d->plaetze[d->oben++ % DEQUE_PLAETZE];
+        DequeFreigeben(d);
+        if (da) {
+            atomic_fetch_sub(&pool.wartend, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void StueckeRechnen(const Aufgabe* a) {
+    for (int b = a->begin; b < a->end && !Abgebrochen(); b += a->grain) {
+        a->fn(a->ctx, b, b + a->grain < a->end ? b + a->grain : a->end);
+        if (threadAbbruch) atomic_fetch_add_explicit(&threadAbbruch->fertig, 1, memory_order_relaxed);
+    }
+}
+
+// Ohne Worker oder im deterministischen Modus wird nichts abgelegt.
+static bool PoolSeriell(void) {
+    return pool.count == 0 || pool.deterministisch;
+}
+
+static void AufgabeAusfuehren(Aufgabe a) {
+    double start = threadTiefe == 0 ? NowSeconds() : 0.0;
+    AbbruchMarke* vorher = threadAbbruch;
+    threadAbbruch = a.gruppe->abbruch;
+    threadTiefe++;
+
+    // Rechte Hälften auf ganze Stücke gerundet ablegen, bis eins übrig ist.
+    while (!PoolSeriell() && !Abgebrochen() && a.end - a.begin > a.grain) {
+        int stuecke = (a.end - a.begin + a.grain - 1) / a.grain;
+        Aufgabe rechts = a;
+        rechts.begin = a.begin + stuecke / 2 * a.grain;
+        atomic_fetch_add(&a.gruppe->offen, 1);
+        if (!AufgabeAblegen(&rechts)) {
+            atomic_fetch_sub(&a.gruppe->offen, 1);
+            break;                  // Deque voll: den Rest hier der Reihe nach
+        }
+        a.end = rechts.begin;
+    }
+    StueckeRechnen(&a);
+
+    threadTiefe--;
+    threadAbbruch = vorher;
+    if (threadTiefe == 0) {
+        atomic_fetch_add(&pool.deques[threadPlatz].rechenNs, (long long)((NowSeconds() - start) * 1e9));
+    }
+    atomic_fetch_sub(&a.gruppe->offen, 1);
+}
+
+static void* WorkerMain(void* arg) {
+    threadPlatz = (int)(intptr_t)arg;
+
+    while (atomic_load(&pool.running)) {
+        Aufgabe a;
+        if (AufgabeHolen(&a)) {
+            AufgabeAusfuehren(a);
+            continue;
+        }
+        pthread_mutex_lock(&pool.mutex);
+        atomic_fetch_add(&pool.schlafend, 1);
+        while (atomic_load(&pool.running) && atomic_load(&pool.wartend) == 0) {
+            pthread_cond_wait(&pool.wake, &pool.mutex);
+        }
+        atomic_fetch_sub(&pool.schlafend, 1);
+        pthread_mutex_unlock(&pool.mutex);
+    }
+    return NULL;
+}
+
+static inline void InitThreads(void) {
+    if (atomic_load(&pool.running)) return;
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    if (cores > THREADS_MAX) cores = THREADS_MAX;
+
+    const char* det = getenv("DOPPELSPALT_DETERMINISTISCH");
+    pool.deterministisch = det && det[0] == '1';
+
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.wake, NULL);
+    for (int i = 0; i < THREADS_MAX + 1 + THREADS_FREMD; i++) atomic_flag_clear(&pool.deques[i].sperre);
+    atomic_store(&pool.running, true);
+    pool.count = 0;
+    pool.messStart = NowSeconds();
+
+    for (int i = 0; i < cores - 1; i++) {
+        if (pthread_create(&pool.threads[pool.count], NULL, WorkerMain, (void*)(intptr_t)(pool.count + 1)) != 0) break;
+        pool.count++;
+    }
+}
+
+static inline void ShutdownThreads(void) {
+    if (!atomic_load(&pool.running)) return;
+
+    pthread_mutex_lock(&pool.mutex);
+    atomic_store(&pool.running, false);
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.mutex);
+
+    for (int i = 0; i < pool.count; i++) pthread_join(pool.threads[i], NULL);
+    pool.count = 0;
+}
+
+static inline int ThreadCount(void) {
+    return pool.count + 1;
+}
+
+// Gibt dem aufrufenden Thread eine eigene Deque, damit er ParallelFor
+// gleichzeitig mit dem Render-Thread nutzen kann. Einmal pro Thread.
+static inline bool ThreadAnmelden(void) {
+    int f = atomic_load(&pool.fremde);
+    do {
+        if (f >= THREADS_FREMD) return false;
+    } while (!atomic_compare_exchange_weak(&pool.fremde, &f, f + 1));
+    threadPlatz = THREADS_MAX + 1 + f;
+    return true;
+}
+
+static inline void ThreadsDeterministisch(bool an) {
+    pool.deterministisch = an;
+}
+
+// Startet fn über [0, total) in Stücken zu höchstens grain Elementen als
+// Teil der Gruppe g und kehrt sofort zurück; GruppeWarten wartet auf alle.
+static inline void GruppeStarten(AufgabenGruppe* g, int total, int grain, ParallelFn fn, void* ctx) {
+    if (total <= 0) return;
+    if (grain < 1) grain = 1;
+    g->abbruch = threadAbbruch;
+    if (g->abbruch) atomic_fetch_add(&g->abbruch->gesamt, (total + grain - 1) / grain);
+    Aufgabe a = {fn, ctx, 0, total, grain, g};
+
+    atomic_fetch_add(&g->offen, 1);
+    if (PoolSeriell() || total <= grain || !AufgabeAblegen(&a)) AufgabeAusfuehren(a);
+}
+
+// Arbeitet mit, bis alle Aufgaben der Gruppe fertig sind.
+static inline void GruppeWarten(AufgabenGruppe* g) {
+    while (atomic_load(&g->offen) > 0) {
+        Aufgabe a;
+        if (AufgabeHolen(&a)) AufgabeAusfuehren(a);
+        else sched_yield();
+    }
+}
+
+// Ruft fn(ctx, begin, end) für Stücke von höchstens grain Elementen auf,
+// bis [0, total) abgearbeitet ist. Kehrt erst zurück, wenn alles fertig ist.
+static inline void ParallelFor(int total, int grain, ParallelFn fn, void* ctx) {
+    AufgabenGruppe g = {0};
+    GruppeStarten(&g, total, grain, fn, ctx);
+    GruppeWarten(&g);
+}
+
+// Anteil der Rechenzeit je Thread seit der letzten Messung (alle 0.5 s neu).
+static inline const char* ThreadsAuslastung(void) {
+    double jetzt = NowSeconds();
+    double dauer = jetzt - pool.messStart;
+    if (dauer >= 0.5 || pool.auslastung[0] == 0) {
+        int n = snprintf(pool.auslastung, sizeof(pool.auslastung), "Threads%s:",
+                         pool.deterministisch ? " (deterministisch)" : "");
+        for (int k = 0; k < DequeAnzahl() && n < (int)sizeof(pool.auslastung) - 8; k++) {
+            int i = DequePlatz(k);
+            long long stand = atomic_load(&pool.deques[i].rechenNs);
+            double anteil = dauer > 0.0 ? (stand - pool.messStand[i]) * 1e-9 / dauer : 0.0;
+            pool.messStand[i] = stand;
+            n += snprintf(pool.auslastung + n, sizeof(pool.auslastung) - n, " %.0f%%", 100.0 * anteil);
+        }
+        pool.messStart = jetzt;
+    }
+    return pool.auslastung;
+}
+
+#endif // THREADS_C_
@@ -0,0 +1,152 @@
+// Weisslicht.c
+// Breitbandige Quelle: die Zwei-Quellen-Intensität 1 + cos(k (r1 - r2 + d sin phi))
+// wird über ein Spektrum von 380 bis 780 nm aufsummiert und über die
+// CIE-Normspektralwertfunktionen nach sRGB gebracht. lambda ist dabei die
+// Pixelwellenlänge von 550 nm. Die Proben liegen gleichabständig in k, so
+// dass cos/sin pro Pixel per Drehung weitergeschaltet werden können; alle
+// WEISS_RESEED Proben wird mit FastCos/FastSin neu aufgesetzt.
+//
+// Gerechnet wird im Simulationsthread (Simulation.c), der auch die Textur
+// für den Render-Thread bereitstellt.
+#include <math.h>
+#include <string.h>
+
+#define WEISS_MIN_SAMPLES 64
+#define WEISS_MAX_SAMPLES 256
+#define WEISS_NM_MIN 380.0
+#define WEISS_NM_MAX 780.0
+#define WEISS_NM_REF 550.0
+#define WEISS_RESEED 32
+
+typedef struct {
+    int proben;
+    float k0, dk;                   // Wellenzahl der ersten Probe, Abstand in 1/px
+    float wx[WEISS_MAX_SAMPLES];    // Gewichte: Spektralwert * dlambda/dk
+    float wy[WEISS_MAX_SAMPLES];
+    float wz[WEISS_MAX_SAMPLES];
+    float versatz;                  // d sin phi, Gangunterschied an den Spalten
+    float weissR, weissG, weissB;   // Kehrwerte für Weißabgleich
+
+    FeldGeometrie* geometrie;
+} Weisslicht;
+
+// Mehrkeulen-Näherung der CIE-1931-Funktionen (Wyman, Sloan, Shirley 2013).
+static double CieKeule(double l, double mu, double s1, double s2) {
+    double t = (l - mu) / (l < mu ? s1 : s2);
+    return exp(-0.5 * t * t);
+}
+
+static void CieXyz(double nm, double* x, double* y, double* z) {
+    *x = 1.056 * CieKeule(nm, 599.8, 37.9, 31.0) + 0.362 * CieKeule(nm, 442.0, 16.0, 26.7) -
+         0.065 * CieKeule(nm, 501.1, 20.4, 26.2);
+    *y = 0.821 * CieKeule(nm, 568.8, 46.9, 40.5) + 0.286 * CieKeule(nm, 530.9, 16.3, 31.1);
+    *z = 1.217 * CieKeule(nm, 437.0, 11.8, 36.0) + 0.681 * CieKeule(nm, 459.0, 26.0, 13.8);
+}
+
+static void XyzToLinearRgb(float x, float y, float z, float* r, float* g, float* b) {
+    *r = 3.2406f * x - 1.5372f * y - 0.4986f * z;
+    *g = -0.9689f * x + 1.8758f * y + 0.0415f * z;
+    *b = 0.0557f * x - 0.2040f * y + 1.0570f * z;
+}
+
+static void BuildSpektrum(Weisslicht* w, int proben, AppState* state) {
+    double pxProNm = state->lambda / WEISS_NM_REF;
+    double kMin = 2.0 * PI / (WEISS_NM_MAX * pxProNm);
+    double kMax = 2.0 * PI / (WEISS_NM_MIN * pxProNm);
+
+    w->proben = proben;
+    w->dk = (float)((kMax - kMin) / proben);
+    w->k0 = (float)(kMin + 0.5 * w->dk);
+
+    double summeX = 0.0, summeY = 0.0, summeZ = 0.0;
+    for (int j = 0; j < proben; j++) {
+        double k = w->k0 + j * w->dk;
+        double nm = 2.0 * PI / k / pxProNm;
+        double x, y, z;
+        CieXyz(nm, &x, &y, &z);
+        double jacobi = nm * nm;    // flaches Spektrum in lambda
+        w->wx[j] = (float)(x * jacobi);
+        w->wy[j] = (float)(y * jacobi);
+        w->wz[j] = (float)(z * jacobi);
+        summeX += w->wx[j];
+        summeY += w->wy[j];
+        summeZ += w->wz[j];
+    }
+    for (int j = 0; j < proben; j++) {
+        w->wx[j] /= (float)summeY;
+        w->wy[j] /= (float)summeY;
+        w->wz[j] /= (float)summeY;
+    }
+
+    // Weißabgleich: überall I = 1 soll (1, 1, 1) ergeben, das helle
+    // Hauptmaximum (I = 2) wird dadurch reinweiß.
+    float r, g, b;
+    XyzToLinearRgb((float)(summeX / summeY), 1.0f, (float)(summeZ / summeY), &r, &g, &b);
+    w->weissR = 0.5f / r;
+    w->weissG = 0.5f / g;
+    w->weissB = 0.5f / b;
+
+    double phi = (state->winkel - 90) * PI / 180.0;
+    w->versatz = (float)(state->gitterD * sin(phi));
+}
+
+static void WeisslichtKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Weisslicht* w = (Weisslicht*)ctx;
+    const FeldGeometrie* g = w->geometrie;
+    const int n = x1 - x0;
+    const float* r1 = g->r1 + (size_t)y * g->breite + x0;
+    const float* r2 = g->r2 + (size_t)y * g->breite + x0;
+
+    float d[FELD_TILE], c[FELD_TILE], s[FELD_TILE], cd[FELD_TILE], sd[FELD_TILE];
+    float ax[FELD_TILE], ay[FELD_TILE], az[FELD_TILE];
+
+    for (int i = 0; i < n; i++) {
+        d[i] = r1[i] - r2[i] + w->versatz;
+        cd[i] = FastCos(w->dk * d[i]);
+        sd[i] = FastSin(w->dk * d[i]);
+        ax[i] = ay[i] = az[i] = 0.0f;
+    }
+
+    for (int j0 = 0; j0 < w->proben; j0 += WEISS_RESEED) {
+        float k = w->k0 + j0 * w->dk;
+        for (int i = 0; i < n; i++) {
+            c[i] = FastCos(k * d[i]);
+            s[i] = FastSin(k * d[i]);
+        }
+
+        int j1 = j0 + WEISS_RESEED < w->proben ? j0 + WEISS_RESEED : w->proben;
+        for (int j = j0; j < j1; j++) {
+            float wx = w->wx[j], wy = w->wy[j], wz = w->wz[j];
+            for (int i = 0; i < n; i++) {
+                ax[i] += wx * c[i];
+                ay[i] += wy * c[i];
+                az[i] += wz * c[i];
+                float cn = c[i] * cd[i] - s[i] * sd[i];
+                s[i] = s[i] * cd[i] + c[i] * sd[i];
+                c[i] = cn;
+            }
+        }
+    }
+
+    // Summe der Gewichte ist (X, 1, Z) des Weißpunkts, dazu der Interferenzterm.
+    float wx = 0.0f, wz = 0.0f;
+    for (int j = 0; j < w->proben; j++) {
+        wx += w->wx[j];
+        wz += w->wz[j];
+    }
+    for (int i = 0; i < n; i++) {
+        float r, gr, b;
+        XyzToLinearRgb(wx + ax[i], 1.0f + ay[i], wz + az[i], &r, &gr, &b);
+        out[i] = (Color){LinearToSrgb(r * w->weissR), LinearToSrgb(gr * w->weissG), LinearToSrgb(b * w->weissB), 255};
+    }
+}
+
+// Füllt pixels (g->breite x g->hoehe) für state, ohne Textur.
+static void WeisslichtRechnen(Weisslicht* w, FeldGeometrie* g, Color* pixels, AppState* state, int proben) {
+    if (proben < WEISS_MIN_SAMPLES) proben = WEISS_MIN_SAMPLES;
+    if (proben > WEISS_MAX_SAMPLES) proben = WEISS_MAX_SAMPLES;
+
+    w->geometrie = g;
+    BuildSpektrum(w, proben, state);
+    FeldPixelFuellen(pixels, g->breite, g->hoehe, WeisslichtKernel, w);
+}
@@ -0,0 +1,195 @@
+// Winkelspektrum.c
+// Nahfeld hinter der Wand nach der Methode des Winkelspektrums: das Feld
+// direkt hinter der Wand U0(y) = Maske(y) exp(-i k y sin phi) wird einmal
+// transformiert, A = FFT(U0). Für jede Bildspalte im Abstand z gilt
+//   U(z, y) = IFFT(A(ky) exp(i kz z)),  kz = sqrt(k² - ky²),
+// evaneszente Anteile (|ky| > k) klingen mit exp(-sqrt(ky² - k²) z) ab.
+// Das Spektrum A wird für alle Abstände wiederverwendet, die Spalten
+// verteilt der Thread-Pool. Die Maske kommt aus Blende.c, solange dort eine
+// 1D-Blende existiert, sonst aus der Spaltgeometrie.
+//
+// kz z erreicht bei breiten Fenstern über 1e3 rad, wo FastSinCos schon an
+// Genauigkeit verliert und float selbst nur noch auf 1e-4 rad genau ist; die
+// Phase wird deshalb in double auf [-pi, pi] gebracht und erst dann float.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WINKEL_SPALTEN 8            // Spalten pro Auftrag an den Thread-Pool
+#define WINKEL_2PI 6.283185307179586
+#define WINKEL_RUND 6755399441055744.0 // 1.5 * 2^52: Addition rundet auf ganze Zahl
+
+typedef struct {
+    int n;                          // FFT-Länge, Zweierpotenz >= 2 * Fensterhöhe
+    float* spektrumRe;              // A(ky)
+    float* spektrumIm;
+    double* kz;                     // Realteil von kz, 0 für evaneszente Anteile
+    float* daempfung;               // Imaginärteil von kz
+    int evaneszentVon, evaneszentBis;
+    float* intensitaet;             // |U|² * z, spaltenweise: breite * hoehe
+
+    FeldGeometrie* geometrie;
+    FeldBild bild;
+    float maxWert;
+
+    int width, height, blendeVersion;
+    AppState gebaut;
+    double rechenzeit;
+} Winkelspektrum;
+
+static Winkelspektrum winkelspektrum = {0};
+
+static void BuildWinkelspektrum(Winkelspektrum* w, int height, AppState* state) {
+    int n = 1;
+    while (n < 2 * height) n *= 2;
+    if (n != w->n) {
+        free(w->spektrumRe);
+        free(w->spektrumIm);
+        free(w->kz);
+        free(w->daempfung);
+        w->n = n;
+        w->spektrumRe = malloc(n * sizeof(float));
+        w->spektrumIm = malloc(n * sizeof(float));
+        w->kz = malloc(n * sizeof(double));
+        w->daempfung = malloc(n * sizeof(float));
+    }
+
+    double k = 2.0 * PI / state->lambda;
+    double sinPhi = sin((state->winkel - 90) * PI / 180.0);
+    Spalt s = SpaltGeometrie(0, height, state);
+    // Eine bemalte Maske gilt in relativer Höhe und für jedes gitterD.
+    bool maske = blende.n > 0 && !blende.zweiD &&
+                 (blende.bemalt || (blende.height == height && blende.gitterD == state->gitterD));
+
+    memset(w->spektrumRe, 0, n * sizeof(float));
+    memset(w->spektrumIm, 0, n * sizeof(float));
+    for (int y = 0; y < height; y++) {
+        float t = maske ? blende.maske[(size_t)y * blende.n / height] : !IstWand(s, 0.0f, y + 0.5f);
+        double phase = -k * (y + 0.5 - height / 2.0) * sinPhi;
+        w->spektrumRe[y] = t * (float)cos(phase);
+        w->spektrumIm[y] = t * (float)sin(phase);
+    }
+    Fft(GetFftPlan(n), w->spektrumRe, w->spektrumIm, false);
+
+    // Normierung der inversen FFT gleich ins Spektrum.
+    for (int m = 0; m < n; m++) {
+        w->spektrumRe[m] /= n;
+        w->spektrumIm[m] /= n;
+        int f = m < n / 2 ? m : m - n;
+        double ky = 2.0 * PI * f / n;
+        double q = k * k - ky * ky;
+        w->kz[m] = q > 0.0 ? sqrt(q) : 0.0;
+        w->daempfung[m] = q < 0.0 ? (float)sqrt(-q) : 0.0f;
+    }
+
+    w->evaneszentVon = n / 2;
+    while (w->evaneszentVon > 0 && w->daempfung[w->evaneszentVon - 1] > 0.0f) w->evaneszentVon--;
+    w->evaneszentBis = n / 2;
+    while (w->evaneszentBis < n && w->daempfung[w->evaneszentBis] > 0.0f) w->evaneszentBis++;
+}
+
+static void WinkelspektrumSpalten(void* ctx, int begin, int end) {
+    Winkelspektrum* w = (Winkelspektrum*)ctx;
+    const FeldGeometrie* g = w->geometrie;
+    const int n = w->n;
+    const FftPlan* plan = GetFftPlan(n);
+
+    static _Thread_local float* puffer = NULL;
+    static _Thread_local int pufferGroesse = 0;
+    if (pufferGroesse < n) {
+        free(puffer);
+        puffer = malloc(2 * n * sizeof(float));
+        pufferGroesse = n;
+    }
+    float* restrict re = puffer;
+    float* restrict im = puffer + n;
+
+    for (int spalte = begin; spalte < end; spalte++) {
+        float z = g->x0 + spalte + 0.5f - g->spalt.xSpalt;
+
+        for (int m = 0; m < n; m++) {
+            double t = w->kz[m] * z;
+            t -= WINKEL_2PI * ((t * (1.0 / WINKEL_2PI) + WINKEL_RUND) - WINKEL_RUND);
+            float c, s;
+            FastSinCos((float)t, &s, &c);
+            re[m] = w->spektrumRe[m] * c - w->spektrumIm[m] * s;
+            im[m] = w->spektrumRe[m] * s + w->spektrumIm[m] * c;
+        }
+        // Evaneszente Anteile liegen zusammenhängend um die Nyquist-Frequenz.
+        for (int m = w->evaneszentVon; m < w->evaneszentBis; m++) {
+            float betrag = expf(-w->daempfung[m] * z);
+            re[m] *= betrag;
+            im[m] *= betrag;
+        }
+        Fft(plan, re, im, true);
+
+        float* out = w->intensitaet + (size_t)spalte * g->hoehe;
+        for (int y = 0; y < g->hoehe; y++) {
+            out[y] = (re[y] * re[y] + im[y] * im[y]) * z;
+        }
+    }
+}
+
+static void WinkelspektrumKernel(void* ctx, int y, int x0, int x1, Color* out) {
+    Winkelspektrum* w = (Winkelspektrum*)ctx;
+    const int hoehe = w->geometrie->hoehe;
+    float skala = 1.0f / w->maxWert;
+
+    for (int x = x0; x < x1; x++) {
+        float v = sqrtf(fminf(w->intensitaet[(size_t)x * hoehe + y] * skala, 1.0f));
+        unsigned char c = (unsigned char)(255.0f * v);
+        out[x - x0] = (Color){c, (unsigned char)(c / 3), 0, 255};
+    }
+}
+
+void DrawWinkelspektrum(int width, int height, AppState* state) {
+    Winkelspektrum* w = &winkelspektrum;
+    int blendeVersion = blende.zweiD ? -1 : blende.version;
+
+    if (w->width != width || w->height != height || w->blendeVersion != blendeVersion ||
+        w->gebaut.lambda != state->lambda || w->gebaut.gitterD != state->gitterD ||
+        w->gebaut.winkel != state->winkel) {
+        FeldGeometrie* g = GetFeldGeometrie(width, height, state);
+        if (w->width != width || w->height != height) {
+            free(w->intensitaet);
+            w->intensitaet = malloc((size_t)g->breite * g->hoehe * sizeof(float));
+        }
+        w->geometrie = g;
+
+        double start = NowSeconds();
+        BuildWinkelspektrum(w, height, state);
+        ParallelFor(g->breite, WINKEL_SPALTEN, WinkelspektrumSpalten, w);
+        w->rechenzeit = NowSeconds() - start;
+
+        // Die ersten Spalten direkt an der Wand bestimmen sonst die Skala.
+        w->maxWert = 1e-20f;
+        for (int x = g->breite / 8; x < g->breite; x++) {
+            const float* spalte = w->intensitaet + (size_t)x * g->hoehe;
+            for (int y = 0; y < g->hoehe; y++) w->maxWert = fmaxf(w->maxWert, spalte[y]);
+        }
+
+        PrepareFeldBild(&w->bild, g->x0, g->breite, g->hoehe);
+        FillFeldBild(&w->bild, WinkelspektrumKernel, w);
+
+        w->width = width;
+        w->height = height;
+        w->blendeVersion = blendeVersion;
+        w->gebaut = *state;
+    }
+
+    DrawFeldBild(&w->bild);
+    overlay_text(TextFormat("Winkelspektrum: %d Spalten, FFT %d, %.1f ms, %.0f Spalten/s",
+                            w->geometrie->breite, w->n, w->rechenzeit * 1000.0,
+                            w->geometrie->breite / w->rechenzeit));
+}
+
+void UnloadWinkelspektrum(void) {
+    Winkelspektrum* w = &winkelspektrum;
+    free(w->spektrumRe);
+    free(w->spektrumIm);
+    free(w->kz);
+    free(w->daempfung);
+    free(w->intensitaet);
+    FreeFeldBild(&w->bild);
+    memset(w, 0, sizeof(*w));
+}
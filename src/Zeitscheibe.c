@@ -0,0 +1,118 @@
+// Zeitscheibe.c
+// Kooperative, stückweise Rechnung im Render-Thread für Arbeit, die nicht in
+// einen Frame passt (großer Schirm, dichtes Gitter), gedacht für Rechner mit
+// einem Kern oder gedrosseltem Takt, auf denen Worker nicht helfen. Eine
+// Scheibenarbeit besteht aus gesamt fortsetzbaren Einheiten; jeder Aufruf
+// von ScheibenarbeitWeiter rechnet Einheiten, bis das Budget des Frames
+// verbraucht ist, und macht im nächsten Frame weiter. Der Aufrufer zeigt den
+// fertigen Teil schon an.
+//
+// Die Stückgröße richtet sich nach den gemessenen Kosten je Einheit, die
+// über Neustarts erhalten bleiben; gerechnet wird nur, was voraussichtlich
+// noch ins Budget passt. Jeder Aufruf rechnet aber mindestens eine Einheit,
+// sonst käme eine Arbeit hinter einer anderen nie voran. Das Budget kommt
+// aus DOPPELSPALT_FRAMEBUDGET_MS (Vorgabe ZS_BUDGET_MS), das Overlay
+// vergleicht es mit der tatsächlichen Rechenzeit und der erreichten
+// Framezeit.
+#include <stdlib.h>
+
+#define ZS_BUDGET_MS 8.0            // Rechenzeit je Frame, Rest bleibt fürs Zeichnen
+#define ZS_ZIEL_FPS 60
+
+typedef void (*ScheibenFn)(void* ctx, int begin, int end);
+
+typedef struct {
+    ScheibenFn fn;
+    void* ctx;
+    int gesamt, fertig;
+    double kosten;                  // geglättete Sekunden je Einheit
+    double dauer;                   // Rechenzeit bisher
+    int frames;                     // über so viele Frames verteilt
+    long frame;                     // letzter Frame mit Rechnung
+} Scheibenarbeit;
+
+typedef struct {
+    double budget;                  // Sekunden je Frame
+    long frame;
+    double verbraucht;              // in diesem Frame
+
+    double arbeitMittel, frameMittel;
+    long aktivFrames, ueberzogen, zuLangsam;
+    double zuletztAktiv;
+} Zeitscheiben;
+
+static Zeitscheiben zeitscheiben = {0};
+
+static void ScheibenarbeitStarten(Scheibenarbeit* a, int gesamt, ScheibenFn fn, void* ctx) {
+    a->fn = fn;
+    a->ctx = ctx;
+    a->gesamt = gesamt;
+    a->fertig = 0;
+    a->dauer = 0.0;
+    a->frames = 0;
+    a->frame = -1;
+}
+
+static bool ScheibenarbeitFertig(const Scheibenarbeit* a) {
+    return a->fertig >= a->gesamt;
+}
+
+// Rechnet bis zum Ende des Frame-Budgets weiter; true, wenn alles fertig ist.
+static bool ScheibenarbeitWeiter(Scheibenarbeit* a) {
+    Zeitscheiben* z = &zeitscheiben;
+    if (ScheibenarbeitFertig(a)) return true;
+    if (a->frame != z->frame) {
+        a->frame = z->frame;
+        a->frames++;
+    }
+
+    do {
+        double rest = z->budget - z->verbraucht;
+        int n = a->kosten > 0.0 ? (int)(rest / a->kosten) : 1;
+        if (n < 1) n = 1;
+        if (n > a->gesamt - a->fertig) n = a->gesamt - a->fertig;
+
+        double start = NowSeconds();
+        a->fn(a->ctx, a->fertig, a->fertig + n);
+        double dt = NowSeconds() - start;
+
+        a->fertig += n;
+        a->dauer += dt;
+        a->kosten = a->kosten > 0.0 ? 0.5 * (a->kosten + dt / n) : dt / n;
+        z->verbraucht += dt;
+    } while (!ScheibenarbeitFertig(a) && z->verbraucht + a->kosten <= z->budget);
+
+    z->zuletztAktiv = NowSeconds();
+    return ScheibenarbeitFertig(a);
+}
+
+// Einmal zu Beginn jedes Frames, nach overlay_begin: wertet den letzten Frame
+// aus und zeigt die Statistik, solange in der letzten Sekunde gerechnet wurde.
+static void ZeitscheibenFrame(void) {
+    Zeitscheiben* z = &zeitscheiben;
+    if (z->budget == 0.0) {
+        const char* ms = getenv("DOPPELSPALT_FRAMEBUDGET_MS");
+        z->budget = (ms ? atof(ms) : ZS_BUDGET_MS) * 1e-3;
+        if (z->budget <= 0.0) z->budget = ZS_BUDGET_MS * 1e-3;
+    }
+
+    double jetzt = NowSeconds();
+    if (z->verbraucht > 0.0) {
+        double frameZeit = GetFrameTime();
+        z->aktivFrames++;
+        z->arbeitMittel += 0.1 * (z->verbraucht - z->arbeitMittel);
+        z->frameMittel += 0.1 * (frameZeit - z->frameMittel);
+        if (z->verbraucht > 1.1 * z->budget) z->ueberzogen++;
+        if (frameZeit > 1.1 / ZS_ZIEL_FPS) z->zuLangsam++;
+    }
+    z->frame++;
+    z->verbraucht = 0.0;
+
+    if (z->aktivFrames > 0 && jetzt - z->zuletztAktiv < 1.0) {
+        overlay_text(TextFormat("Zeitscheiben: Budget %.1f ms, gerechnet %.1f ms, Frame %.1f ms", z->budget * 1e3,
+                                z->arbeitMittel * 1e3, z->frameMittel * 1e3));
+        overlay_text(TextFormat("  Budget überzogen %.0f%%, Frames über %.1f ms %.0f%% (von %ld)",
+                                100.0 * z->ueberzogen / z->aktivFrames, 1e3 / ZS_ZIEL_FPS,
+                                100.0 * z->zuLangsam / z->aktivFrames, z->aktivFrames));
+    }
+}
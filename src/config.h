@@ -9,6 +9,8 @@
 
 #define MARGIN (FONT_SIZE * 1.0f)
 
+#define PANEL_HOEHE 150
+
 static int active_id = -1;
 
 
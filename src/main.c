@@ -4,6 +4,9 @@
 #include "config.h"
 
 #include "Items.c"
+#include "Threads.c"
+#include "FastMath.c"
+#include "Qualitaet.c"
 
 #include <stdlib.h>
 #include <assert.h>
@@ -18,7 +21,62 @@ typedef struct {
 
 AppState state = {50, 75, 90, 1.5, 40};
 
-void DrawKugelwelle(int x, int y, int breite, int hoehe, AppState* state, Color color) {
+typedef struct {
+    int xSpalt;
+    int ySpalt1;
+    int ySpalt2;
+    int loch;
+} Spalt;
+
+Spalt SpaltGeometrie(int width, int height, AppState* state) {
+    Spalt s;
+    s.xSpalt = width / 3;
+    s.ySpalt1 = (height - state->gitterD) / 2;
+    s.ySpalt2 = (height + state->gitterD) / 2;
+    s.loch = 5;
+    return s;
+}
+
+// Liegt der Punkt in einem der drei Wandrechtecke aus DrawSinAndWall?
+bool IstWand(Spalt s, float x, float y) {
+    bool loch1 = y >= s.ySpalt1 - s.loch && y < s.ySpalt1 + s.loch;
+    bool loch2 = y >= s.ySpalt2 - s.loch && y < s.ySpalt2 + s.loch;
+    return x >= s.xSpalt - 2 && x < s.xSpalt + 3 && !loch1 && !loch2;
+}
+
+// Die beiden Spalte als Kugelwellenquellen. s1, s2 sind der Vorlauf der
+// ebenen Welle an den Spalten wie s0 in DrawKugelwelle (ohne Rundung), die
+// Welle von Spalt j hat also am Abstand r die Phase k * (r - sj).
+typedef struct {
+    float x, y1, y2;
+    float k;
+    float s1, s2;
+} Quellen;
+
+Quellen QuellenGeometrie(int width, int height, AppState* state) {
+    Spalt s = SpaltGeometrie(width, height, state);
+    double phi = (state->winkel - 90) * PI / 180.0;
+    double s0 = (double)state->gitterD / 2.0 * sin(phi);
+
+    Quellen q;
+    q.x = (float)s.xSpalt;
+    q.y1 = (float)s.ySpalt1;
+    q.y2 = (float)s.ySpalt2;
+    q.k = (float)(2.0 * PI / state->lambda);
+    q.s1 = (float)-s0;
+    q.s2 = (float)s0;
+    return q;
+}
+
+// Reichweite der Kugelwellen: Diagonale des Bereichs rechts der Wand.
+int KugelwelleReichweite(int width, int height) {
+    int xSpalt = width / 3;
+    return sqrt((width - xSpalt) * (width - xSpalt) + height * height);
+}
+
+// Radien der Wellenberge um den Spalt bei y bis breite, wie DrawKugelwelle
+// sie zeichnet. Mit radien == NULL wird nur gezählt.
+int KugelwelleRadien(int y, int breite, int hoehe, AppState* state, int* radien) {
     int s0;
     double phi = (state->winkel - 90) * PI / 180.0;
 
@@ -28,16 +86,185 @@ void DrawKugelwelle(int x, int y, int breite, int hoehe, AppState* state, Color
         s0 = -(int)((double) state->gitterD / 2.0 * sin(phi)) % state->lambda;
     }
 
+    int n = 0;
     for (int i = 0; i * state->lambda + s0 < breite; i++) {
         int radius = i * state->lambda + s0;
-
-        Vector2 centerVec = {x, y};
         if (radius > 0) {
-            DrawCircleSectorLines(centerVec, radius, -90.0f, 90.0f, 100, color);
-            //DrawCircleLines(x, y, radius, color);
+            if (radien) radien[n] = radius;
+            n++;
+        }
+    }
+    return n;
+}
 
+// Wellenfronten der einfallenden ebenen Welle links der Wand als Strecken
+// (je zwei Punkte), wie DrawVerticalLines sie zeichnet. Mit strecken == NULL
+// wird nur gezählt.
+int EbeneWelleStrecken(int breite, int hoehe, int lambda, int winkel, Vector2* strecken) {
+    double dWinkel = winkel * PI / 180.0;
+    int n = 0;
+
+    if (winkel == 90) {
+        for (int i = breite; i > 0; i -= lambda) {
+            if (strecken) {
+                strecken[2 * n] = (Vector2){i, 0};
+                strecken[2 * n + 1] = (Vector2){i, hoehe};
+            }
+            n++;
+        }
+    } else if (winkel == 0 || winkel == 180) {
+        for (int i = (hoehe / 2) % lambda; i <= hoehe; i += lambda) {
+            if (strecken) {
+                strecken[2 * n] = (Vector2){0, i};
+                strecken[2 * n + 1] = (Vector2){breite, i};
+            }
+            n++;
+        }
+    } else {
+        double nX = sin(dWinkel);
+        double nY = cos(dWinkel);
+
+        double d0, d1, dMin, dMax;
+        if (winkel < 90) {
+            dMin = 0.0;
+            d1 = (double)breite * nX + (double)hoehe / 2.0 * nY;
+            dMax = (double)breite * nX + (double)hoehe * nY;
+        } else {
+            dMin = (double)hoehe * nY;
+            d1 = (double)breite * nX + (double)hoehe / 2.0 * nY;
+            dMax = (double)breite * nX;
+        }
+
+        d0 = dMin + fmod(d1 - dMin, (double)lambda);
+        for (double d = d0; d < dMax; d += (double)lambda) {
+            int x0, y0, x1, y1;
+
+            double schnittX_Achse = d / nY;
+            double schnittY_Achse = d / nX;
+            double schnittX_breite = (d - (double)breite * nX) / nY;
+            double schnittY_hoehe = (d - (double)hoehe * nY) / nX;
+
+            if (schnittY_Achse < 0.0) {
+                x0 = 0;
+                y0 = (int)schnittX_Achse;
+            } else if (schnittY_Achse < (double)breite) {
+                x0 = (int)schnittY_Achse;
+                y0 = 0;
+            } else {
+                x0 = breite;
+                y0 = (int)schnittX_breite;
+            }
+
+            if (schnittY_hoehe < 0.0) {
+                x1 = 0;
+                y1 = (int)schnittX_Achse;
+            } else if (schnittY_hoehe < (double)breite) {
+                x1 = (int)schnittY_hoehe;
+                y1 = hoehe;
+            } else {
+                x1 = breite;
+                y1 = (int)schnittX_breite;
+            }
+
+            if (strecken) {
+                strecken[2 * n] = (Vector2){x0, y0};
+                strecken[2 * n + 1] = (Vector2){x1, y1};
+            }
+            n++;
         }
     }
+    return n;
+}
+
+#include "Fdtd.c"
+#include "Fft.c"
+#include "Schroedinger.c"
+#include "Bohm.c"
+#include "Zeitscheibe.c"
+#include "Feld.c"
+#include "Weisslicht.c"
+#include "Kohaerenz.c"
+#include "Blende.c"
+#include "Winkelspektrum.c"
+#include "Kontur.c"
+#include "Hyperbel.c"
+#include "Eikonal.c"
+#include "Fit.c"
+#include "Schirm.c"
+#include "Mehrquellen.c"
+#include "Feldabfrage.c"
+#include "Sonde.c"
+#include "Lupe.c"
+#include "Atlas.c"
+#include "Simulation.c"
+
+typedef enum {
+    MODUS_GEOMETRIE = 0,
+    MODUS_FDTD,
+    MODUS_SCHROEDINGER,
+    MODUS_BOHM,
+    MODUS_WEISSLICHT,
+    MODUS_KOHAERENZ,
+    MODUS_BLENDE,
+    MODUS_WINKELSPEKTRUM,
+    MODUS_KONTUR,
+    MODUS_HYPERBEL,
+    MODUS_EIKONAL,
+    MODUS_FIT,
+    MODUS_SCHIRM,
+    MODUS_MEHRQUELLEN,
+    MODUS_LUPE,
+    MODUS_ANZAHL
+} Modus;
+
+const char* modusNamen[MODUS_ANZAHL] = {
+    "Geometrie",
+    "FDTD Ripple-Tank",
+    "Schrödinger-Wellenpaket",
+    "Bohmsche Bahnen",
+    "Weißlicht",
+    "Ausgedehnte Quelle",
+    "Blende und Fernfeld",
+    "Nahfeld (Winkelspektrum)",
+    "Knoten- und Bauchlinien",
+    "Hyperbeln (geschlossen)",
+    "Brechzahlkarte (Eikonal)",
+    "Fit aus Schirmbild",
+    "Schirmbild (Lochblenden)",
+    "Freie Quellen",
+    "Lupe (Kachelcache)",
+};
+
+Modus modus = MODUS_GEOMETRIE;
+
+// Zusätzlicher Schieberegler über Lambda, dessen Bedeutung vom Modus abhängt.
+typedef struct {
+    const char* label;
+    float min, max;
+    float wert;
+} Regler;
+
+Regler modusRegler[MODUS_ANZAHL] = {
+    [MODUS_WEISSLICHT] = {"N", 64, 256, 128},
+    [MODUS_KOHAERENZ] = {"Breite", 0, 20, 2},
+    [MODUS_EIKONAL] = {"n", 1, 2.5, 1.5},
+    [MODUS_SCHIRM] = {"N", 2, 16, 4},
+};
+
+void DrawKugelwelleRadien(int x, int y, const int* radien, int n, Color color) {
+    Vector2 centerVec = {x, y};
+    for (int i = 0; i < n; i++) {
+        DrawCircleSectorLines(centerVec, radien[i], -90.0f, 90.0f, QualitaetAktuell()->ringSegmente, color);
+        //DrawCircleLines(x, y, radius, color);
+    }
+}
+
+void DrawKugelwelle(int x, int y, int breite, int hoehe, AppState* state, Color color) {
+    int n = KugelwelleRadien(y, breite, hoehe, state, NULL);
+    int* radien = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    KugelwelleRadien(y, breite, hoehe, state, radien);
+    DrawKugelwelleRadien(x, y, radien, n, color);
+    free(radien);
 }
 
 void DrawWavesFromSlits(int screenWidth, int screenHeight, AppState* state) {
@@ -45,42 +272,36 @@ void DrawWavesFromSlits(int screenWidth, int screenHeight, AppState* state) {
     int ySpalt1 = (screenHeight - state->gitterD) / 2;
     int ySpalt2 = (screenHeight + state->gitterD) / 2;
 
-    int sizeFeld = sqrt((screenWidth - xSpalt) * (screenWidth - xSpalt) + screenHeight * screenHeight);
+    int sizeFeld = KugelwelleReichweite(screenWidth, screenHeight);
 
     DrawKugelwelle(xSpalt, ySpalt1, sizeFeld, screenHeight, state, BLACK);
 
     DrawKugelwelle(xSpalt, ySpalt2, sizeFeld, screenHeight, state, BLACK);
 }
 
+// Wellenberge aus dem Simulationsthread, passend zu dessen Punkten.
+void DrawWavesFromSimulation(SimErgebnis* e) {
+    Spalt s = SpaltGeometrie(e->auftrag.width, e->auftrag.height, &e->auftrag.state);
 
-void DrawInterferencePoints(int breite, int hoehe, Color color) {
-    double phi = (state.winkel - 90) * M_PI / 180.0;
-    double s0 = fmod((double) state.gitterD / 2.0 * sin(phi), state.lambda);
-    int nWellen = breite / state.lambda;
-    int tempR3 = 12;
-    if (state.lambda <= 20) tempR3 = 9;
-    if (state.lambda <= 15) tempR3 = 7;
-
-    if (tempR3 < 5) tempR3 = 5;
+    DrawKugelwelleRadien(s.xSpalt, s.ySpalt1, e->radien[0], e->radienAnzahl[0], BLACK);
 
-    for (int i1 = 0; i1 < nWellen; i1++) {
-        for (int i2 = 0; i2 < nWellen; i2++) {
-            double tempR1 = i1 * state.lambda - s0;
-            double tempR2 = i2 * state.lambda + s0;
-
-            if (tempR1 + tempR2 > state.gitterD && tempR1 <= tempR2 + state.gitterD && tempR2 <= tempR1 + state.gitterD) {
-                if (state.gitterD != 0) {
-                    double tempY = (tempR1 * tempR1 - tempR2 * tempR2 + state.gitterD * state.gitterD) / (2.0 * state.gitterD);
-                    double tempX = sqrt(tempR1 * tempR1 - tempY * tempY);
+    DrawKugelwelleRadien(s.xSpalt, s.ySpalt2, e->radien[1], e->radienAnzahl[1], BLACK);
+}
 
-                    int circleX = breite / 3 + (int)tempX;
-                    int circleY = (hoehe - state.gitterD) / 2 + ((int)tempY - tempR3 / 2) + 10;
 
-                    DrawCircle(circleX, circleY, tempR3, color);
+void DrawEbeneWelleStrecken(const Vector2* strecken, int n) {
+    for (int i = 0; i < n; i++) {
+        DrawLine((int)strecken[2 * i].x, (int)strecken[2 * i].y, (int)strecken[2 * i + 1].x, (int)strecken[2 * i + 1].y,
+                 BLACK);
+    }
+}
 
-                }
-            }
-        }
+void DrawInterferencePoints(const Interferenzpunkte* ip, Color color) {
+    const QualitaetStufe* q = QualitaetAktuell();
+    int schritt = ip->anzahl > q->punktGrenze ? (ip->anzahl + q->punktGrenze - 1) / q->punktGrenze : 1;
+    float radius = ip->radius * q->punktRadius;
+    for (int i = 0; i < ip->anzahl; i += schritt) {
+        DrawCircle((int)ip->punkte[i].p.x, (int)ip->punkte[i].p.y, radius, color);
     }
 }
 
@@ -123,69 +344,20 @@ void DrawPlaneWave(int width, int height) {
 }
 
 void DrawVerticalLines(int breite, int hoehe, int lambda, int winkel) {
-    double dWinkel = winkel * PI / 180.0;
-
-    if (winkel == 90) {
-        for (int i = breite; i > 0; i -= lambda)
-            DrawLine(i, 0, i, hoehe, BLACK);
-    } else if (winkel == 0 || winkel == 180) {
-        for (int i = (hoehe / 2) % lambda; i <= hoehe; i += lambda)
-            DrawLine(0, i, breite, i, BLACK);
-    } else {
-        double nX = sin(dWinkel);
-        double nY = cos(dWinkel);
-
-        double d0, d1, dMin, dMax;
-        if (winkel < 90) {
-            dMin = 0.0;
-            d1 = (double)breite * nX + (double)hoehe / 2.0 * nY;
-            dMax = (double)breite * nX + (double)hoehe * nY;
-        } else {
-            dMin = (double)hoehe * nY;
-            d1 = (double)breite * nX + (double)hoehe / 2.0 * nY;
-            dMax = (double)breite * nX;
-        }
-
-        d0 = dMin + fmod(d1 - dMin, (double)lambda);
-        for (double d = d0; d < dMax; d += (double)lambda) {
-            int x0, y0, x1, y1;
-
-            double schnittX_Achse = d / nY;
-            double schnittY_Achse = d / nX;
-            double schnittX_breite = (d - (double)breite * nX) / nY;
-            double schnittY_hoehe = (d - (double)hoehe * nY) / nX;
-
-            if (schnittY_Achse < 0.0) {
-                x0 = 0;
-                y0 = (int)schnittX_Achse;
-            } else if (schnittY_Achse < (double)breite) {
-                x0 = (int)schnittY_Achse;
-                y0 = 0;
-            } else {
-                x0 = breite;
-                y0 = (int)schnittX_breite;
-            }
-
-            if (schnittY_hoehe < 0.0) {
-                x1 = 0;
-                y1 = (int)schnittX_Achse;
-            } else if (schnittY_hoehe < (double)breite) {
-                x1 = (int)schnittY_hoehe;
-                y1 = hoehe;
-            } else {
-                x1 = breite;
-                y1 = (int)schnittX_breite;
-            }
-
-            DrawLine(x0, y0, x1, y1, BLACK);
-        }
-    }
+    int n = EbeneWelleStrecken(breite, hoehe, lambda, winkel, NULL);
+    Vector2* strecken = (Vector2*)malloc((n > 0 ? n : 1) * 2 * sizeof(Vector2));
+    EbeneWelleStrecken(breite, hoehe, lambda, winkel, strecken);
+    DrawEbeneWelleStrecken(strecken, n);
+    free(strecken);
 }
 
-void DrawSinAndWall(int width, int height, AppState* state) {
-    int xSpalt = width / 3; 
-    int ySpalt1 = (height - state->gitterD) / 2;
-    int ySpalt2 = (height + state->gitterD) / 2;
+// sim: Ergebnis des Simulationsthreads, dessen Wellenfronten genutzt werden,
+// wenn sie zum aktuellen Zustand passen.
+void DrawSinAndWall(int width, int height, AppState* state, const SimErgebnis* sim) {
+    Spalt spalt = SpaltGeometrie(width, height, state);
+    int xSpalt = spalt.xSpalt;
+    int ySpalt1 = spalt.ySpalt1;
+    int ySpalt2 = spalt.ySpalt2;
 
     double phi = (state->winkel - 90) * PI / 180.0;
     int lSinus;
@@ -213,14 +385,20 @@ void DrawSinAndWall(int width, int height, AppState* state) {
 
 
     int RectWidth = 5;
-    int loch = 5;
+    int loch = spalt.loch;
 
     DrawRectangle(xSpalt - 2, 0, RectWidth, ySpalt1 - loch, BLACK);
     DrawRectangle(xSpalt - 2, ySpalt1 + loch, RectWidth, ySpalt2 - ySpalt1 - (loch * 2), BLACK);
     DrawRectangle(xSpalt - 2, ySpalt2 + loch, RectWidth, height - ySpalt2 - loch, BLACK);
 
 
-    DrawVerticalLines(xSpalt, height, state->lambda, state->winkel);
+    const AppState* simState = &sim->auftrag.state;
+    if (sim->auftrag.art == SIM_GEOMETRIE && sim->auftrag.width == width && sim->auftrag.height == height &&
+        simState->lambda == state->lambda && simState->winkel == state->winkel) {
+        DrawEbeneWelleStrecken(sim->wellenfront, sim->wellenfrontAnzahl);
+    } else {
+        DrawVerticalLines(xSpalt, height, state->lambda, state->winkel);
+    }
 
     /*
     DrawText(TextFormat("Wavelength (lambda): %d", state->lambda), 10, 10, 20, DARKGRAY);
@@ -234,14 +412,33 @@ void DrawSinAndWall(int width, int height, AppState* state) {
 
 
 
-int main(void) {
+// "./main --pruefen": Prüfungen ohne Fenster, Rückgabe 0 ohne Fehler.
+static int PruefenKommando(int width, int height) {
+    InitThreads();
+    long fehler = HyperbelPruefen(width, height) + HyperbelPruefen(800, 600);
+    fehler += PunktePruefen(width, height) + PunkteAbbruchPruefen(width, height);
+    fehler += FeldAbfragePruefen();
+    ShutdownThreads();
+    return fehler == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
     int screenWidth = 9 * 1920 / 10;
     int screenHeight = 9 * 1080 / 10;
 
+    if (argc >= 2 && strcmp(argv[1], "--atlas") == 0) {
+        return AtlasKommando(argc >= 3 ? argv[2] : ATLAS_DATEI, screenWidth, screenHeight);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--pruefen") == 0) {
+        return PruefenKommando(screenWidth, screenHeight);
+    }
 
     SetConfigFlags(FLAG_MSAA_4X_HINT);
     SetConfigFlags(FLAG_WINDOW_RESIZABLE);
     InitWindow(screenWidth, screenHeight, "Doppelspaltenapp in C - Raylib / Raygui");
+    InitThreads();
+    AtlasOeffnen(&atlas, ATLAS_DATEI);
+    StartSimulation();
 
     float valueLambda = 50;
     float valueD = 75;
@@ -249,10 +446,11 @@ int main(void) {
 
     SetTargetFPS(60);
     while (!WindowShouldClose()) {
+        QualitaetFrameBeginn();
 
 
         //int windowBoxHeight = GetScreenWidth() / 8;
-        int windowBoxHeight = 150;
+        int windowBoxHeight = PANEL_HOEHE;
 
         float ratioSpacing = 6.0f / windowBoxHeight;
         float ratioHeight = 20.0f / windowBoxHeight;
@@ -275,6 +473,9 @@ int main(void) {
         state.gitterD = (int)valueD;
         state.winkel = (int)valueWinkel;
 
+        if (IsKeyPressed(KEY_TAB)) {
+            modus = (modus + 1) % MODUS_ANZAHL;
+        }
 
         screenWidth = GetScreenWidth();
         screenHeight = GetScreenHeight();
@@ -291,14 +492,94 @@ int main(void) {
 
  
         ClearBackground(RAYWHITE);
+        overlay_begin();
+        overlay_text(TextFormat("Modus [TAB]: %s", modusNamen[modus]));
+        overlay_text(ThreadsAuslastung());
+        ZeitscheibenFrame();
+        QualitaetOverlay();
+
+        SimArt simArt = SIM_KEINE;
+        float simRegler = modusRegler[modus].wert;
+        if (modus == MODUS_GEOMETRIE) simArt = SIM_GEOMETRIE;
+        if (modus == MODUS_WEISSLICHT) {
+            simArt = SIM_WEISSLICHT;
+            simRegler = fminf(simRegler, QualitaetAktuell()->proben);
+        }
+        if (modus == MODUS_BOHM) {
+            simArt = SIM_BOHM;
+            simRegler = BohmTasten();
+        }
+        float tempo[3] = {slider_velocity(0), slider_velocity(1), slider_velocity(2)};
+        SimErgebnis* sim = SimAktualisieren(simArt, &state, GetScreenWidth(), GetScreenHeight(), simRegler, tempo);
+
+        switch (modus) {
+        case MODUS_FDTD:
+            DrawFdtd(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_SCHROEDINGER:
+            DrawSchroedinger(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_BOHM:
+            if (sim->auftrag.art == SIM_BOHM) DrawBohm(&sim->bohm);
+            break;
+        case MODUS_WEISSLICHT:
+            DrawSimWeisslicht(sim);
+            break;
+        case MODUS_KOHAERENZ:
+            DrawKohaerenz(GetScreenWidth(), GetScreenHeight(), &state, modusRegler[modus].wert);
+            break;
+        case MODUS_BLENDE:
+            DrawBlende(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_WINKELSPEKTRUM:
+            DrawWinkelspektrum(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_KONTUR:
+            DrawWavesFromSlits(GetScreenWidth(), GetScreenHeight(), &state);
+            DrawRectangleRec(whiteRect, RAYWHITE);
+            DrawKontur(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_HYPERBEL:
+            DrawWavesFromSlits(GetScreenWidth(), GetScreenHeight(), &state);
+            DrawRectangleRec(whiteRect, RAYWHITE);
+            DrawHyperbel(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_EIKONAL:
+            DrawEikonal(GetScreenWidth(), GetScreenHeight(), &state, modusRegler[modus].wert);
+            break;
+        case MODUS_FIT: {
+            AppState gefittet = state;
+            DrawWavesFromSlits(GetScreenWidth(), GetScreenHeight(), &state);
+            DrawRectangleRec(whiteRect, RAYWHITE);
+            if (DrawFit(GetScreenWidth(), GetScreenHeight(), &state, &gefittet)) {
+                valueLambda = gefittet.lambda;
+                valueD = gefittet.gitterD;
+                valueWinkel = gefittet.winkel;
+            }
+            break;
+        }
+        case MODUS_SCHIRM:
+            DrawSchirm(GetScreenWidth(), GetScreenHeight(), &state, (int)modusRegler[modus].wert);
+            break;
+        case MODUS_MEHRQUELLEN:
+            DrawMehrquellen(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        case MODUS_LUPE:
+            DrawLupe(GetScreenWidth(), GetScreenHeight(), &state);
+            break;
+        default:
+            if (sim->auftrag.art != SIM_GEOMETRIE) break;
+            DrawWavesFromSimulation(sim);
+            //DrawInterferencePoints(GetScreenWidth() / 16, GetScreenWidth(), GetScreenHeight(), RED);
+            DrawInterferencePoints(&sim->punkte, RED);
+
+            DrawRectangleRec(whiteRect, RAYWHITE);
+            DrawSonde(&sim->punkte, GetScreenWidth(), GetScreenHeight(), &sim->auftrag.state);
+            break;
+        }
 
-
-        DrawWavesFromSlits(GetScreenWidth(), GetScreenHeight(), &state);
-        //DrawInterferencePoints(GetScreenWidth() / 16, GetScreenWidth(), GetScreenHeight(), RED);
-        DrawInterferencePoints(GetScreenWidth(), GetScreenHeight(), RED);
-
-        DrawRectangleRec(whiteRect, RAYWHITE);
-        DrawSinAndWall(GetScreenWidth(), GetScreenHeight(), &state);
+        DrawSinAndWall(GetScreenWidth(), GetScreenHeight(), &state, sim);
+        if (modus == MODUS_BLENDE) DrawBlendeWand(GetScreenWidth(), GetScreenHeight());
 
 
         DrawRectangleRec(windowBoxBounds, RAYWHITE);
@@ -312,11 +593,36 @@ int main(void) {
         slider(1, boundsD, &valueD, 0, 150, "D", true, 0.0);                  // Slider für "D"
         slider(2, boundsWinkel, &valueWinkel, 0, 180, "Winkel", true, 90.0);  // Slider für "Winkel"
 
+        Regler* regler = &modusRegler[modus];
+        if (regler->label) {
+            Rectangle boundsRegler = boundsLambda;
+            boundsRegler.y = boundsLambda.y - sliderHeight - sliderSpacing;
+            slider(3, boundsRegler, &regler->wert, regler->min, regler->max, regler->label, true, 0.0);
+        }
+
         DrawFPS(10, 10);
+        overlay_end(10, 35);
 
+        QualitaetFrameEnde();
         EndDrawing();
     }
 
+    UnloadFdtd();
+    UnloadSchroedinger();
+    UnloadKohaerenz();
+    UnloadBlende();
+    UnloadWinkelspektrum();
+    UnloadKontur();
+    UnloadHyperbel();
+    UnloadEikonal();
+    UnloadFit();
+    UnloadSchirm();
+    UnloadMehrquellen();
+    UnloadLupe();
+    StopSimulation();
+    AtlasSchliessen(&atlas);
+    FreeFeldGeometrie();
+    ShutdownThreads();
     CloseWindow();
 
     return 0;